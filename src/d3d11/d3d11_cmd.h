@@ -1,5 +1,11 @@
 #pragma once
 
+#include <array>
+
+#include "../dxvk/dxvk_buffer.h"
+#include "../dxvk/dxvk_image.h"
+#include "../dxvk/dxvk_sampler.h"
+
 #include "d3d11_include.h"
 
 namespace dxvk {
@@ -13,6 +19,9 @@ namespace dxvk {
   enum class D3D11CmdType {
     DrawIndirect,
     DrawIndirectIndexed,
+    BindConstantBuffer,
+    BindSampler,
+    BindShaderResources,
   };
 
 
@@ -40,4 +49,52 @@ namespace dxvk {
     uint32_t            stride;
   };
 
-}
\ No newline at end of file
+
+
+  /**
+   * \brief Constant buffer binding command data
+   *
+   * Stores the buffer slice to bind, so that a redundant
+   * binding to the same slot recorded immediately after
+   * can replace it rather than adding a new command.
+   */
+  struct D3D11CmdBindConstantBufferData : public D3D11CmdData {
+    VkShaderStageFlagBits stage;
+    uint32_t            slot;
+    DxvkBufferSlice     slice;
+  };
+
+
+  /**
+   * \brief Sampler binding command data
+   *
+   * Stores the sampler to bind. Works the
+   * same way as constant buffer bindings.
+   */
+  struct D3D11CmdBindSamplerData : public D3D11CmdData {
+    VkShaderStageFlagBits stage;
+    uint32_t            slot;
+    Rc<DxvkSampler>     sampler;
+  };
+
+
+  /**
+   * \brief Shader resource binding command data
+   *
+   * Stores views for a range of consecutive shader resource
+   * slots, so that binding multiple resources at once only
+   * requires a single command. For each slot, at most one
+   * of the two views is non-null.
+   */
+  struct D3D11CmdBindShaderResourcesData : public D3D11CmdData {
+    constexpr static uint32_t MaxCount = 8u;
+
+    VkShaderStageFlagBits stage;
+    uint32_t            slot;
+    uint32_t            count;
+
+    std::array<Rc<DxvkImageView>,  MaxCount> imageViews;
+    std::array<Rc<DxvkBufferView>, MaxCount> bufferViews;
+  };
+
+}
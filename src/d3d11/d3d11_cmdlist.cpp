@@ -112,6 +112,20 @@ namespace dxvk {
           D3D11_RESOURCE_DIMENSION ResourceType,
           UINT                Subresource,
           uint64_t            ChunkId) {
+    // Command lists that get executed multiple times re-apply tracking
+    // for every entry on every submission, so skip resources that were
+    // already tracked for the same chunk recently. Only the sequence
+    // number of each chunk matters, not the number of entries.
+    for (size_t i = 1; i <= std::min<size_t>(m_resources.size(), MaxTrackingLookback); i++) {
+      const auto& prev = m_resources[m_resources.size() - i];
+
+      if (prev.chunkId != ChunkId)
+        break;
+
+      if (prev.ref.Get() == pResource && prev.ref.GetSubresource() == Subresource)
+        return;
+    }
+
     TrackedResource entry;
     entry.ref = D3D11ResourceRef(pResource, Subresource, ResourceType);
     entry.chunkId = ChunkId;
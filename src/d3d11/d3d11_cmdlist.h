@@ -9,7 +9,9 @@ namespace dxvk {
   using D3D11ChunkDispatchProc = std::function<uint64_t (DxvkCsChunkRef&&, GpuFlushType)>;
 
   class D3D11CommandList : public D3D11DeviceChild<ID3D11CommandList> {
-    
+    /// Number of previously tracked resources to
+    /// check for duplicates when adding a new one
+    constexpr static size_t MaxTrackingLookback = 8u;
   public:
     
     D3D11CommandList(
@@ -3651,23 +3651,31 @@ namespace dxvk {
           D3D11Buffer*                      pBuffer,
           UINT                              Offset,
           UINT                              Length) {
-    if (pBuffer) {
-      EmitCs([
-        cSlotId      = Slot,
-        cBufferSlice = pBuffer->GetBufferSlice(16 * Offset, 16 * Length)
-      ] (DxvkContext* ctx) mutable {
-        VkShaderStageFlagBits stage = GetShaderStage(ShaderStage);
-        ctx->bindUniformBuffer(stage, cSlotId,
-          Forwarder::move(cBufferSlice));
-      });
-    } else {
-      EmitCs([
-        cSlotId      = Slot
-      ] (DxvkContext* ctx) {
-        VkShaderStageFlagBits stage = GetShaderStage(ShaderStage);
-        ctx->bindUniformBuffer(stage, cSlotId, DxvkBufferSlice());
-      });
+    DxvkBufferSlice slice = pBuffer
+      ? pBuffer->GetBufferSlice(16 * Offset, 16 * Length)
+      : DxvkBufferSlice();
+
+    // If the previous command bound a constant buffer to the same
+    // slot, it is redundant and we can simply replace the binding
+    VkShaderStageFlagBits stage = GetShaderStage(ShaderStage);
+    auto cmdData = static_cast<D3D11CmdBindConstantBufferData*>(m_cmdData);
+
+    if (cmdData && cmdData->type == D3D11CmdType::BindConstantBuffer
+     && cmdData->stage == stage && cmdData->slot == Slot) {
+      cmdData->slice = std::move(slice);
+      return;
     }
+
+    cmdData = EmitCsCmd<D3D11CmdBindConstantBufferData>(
+      [] (DxvkContext* ctx, D3D11CmdBindConstantBufferData* data) {
+        ctx->bindUniformBuffer(data->stage, data->slot,
+          Forwarder::move(data->slice));
+      });
+
+    cmdData->type   = D3D11CmdType::BindConstantBuffer;
+    cmdData->stage  = stage;
+    cmdData->slot   = Slot;
+    cmdData->slice  = std::move(slice);
   }
   
   
@@ -3693,23 +3701,31 @@ namespace dxvk {
   void D3D11CommonContext<ContextType>::BindSampler(
           UINT                              Slot,
           D3D11SamplerState*                pSampler) {
-    if (pSampler) {
-      EmitCs([
-        cSlotId   = Slot,
-        cSampler  = pSampler->GetDXVKSampler()
-      ] (DxvkContext* ctx) mutable {
-        VkShaderStageFlagBits stage = GetShaderStage(ShaderStage);
-        ctx->bindResourceSampler(stage, cSlotId,
-          Forwarder::move(cSampler));
-      });
-    } else {
-      EmitCs([
-        cSlotId   = Slot
-      ] (DxvkContext* ctx) {
-        VkShaderStageFlagBits stage = GetShaderStage(ShaderStage);
-        ctx->bindResourceSampler(stage, cSlotId, nullptr);
-      });
+    Rc<DxvkSampler> sampler = pSampler
+      ? pSampler->GetDXVKSampler()
+      : nullptr;
+
+    // Replace redundant sampler bindings in place, the
+    // same way we do for constant buffer bindings
+    VkShaderStageFlagBits stage = GetShaderStage(ShaderStage);
+    auto cmdData = static_cast<D3D11CmdBindSamplerData*>(m_cmdData);
+
+    if (cmdData && cmdData->type == D3D11CmdType::BindSampler
+     && cmdData->stage == stage && cmdData->slot == Slot) {
+      cmdData->sampler = std::move(sampler);
+      return;
     }
+
+    cmdData = EmitCsCmd<D3D11CmdBindSamplerData>(
+      [] (DxvkContext* ctx, D3D11CmdBindSamplerData* data) {
+        ctx->bindResourceSampler(data->stage, data->slot,
+          Forwarder::move(data->sampler));
+      });
+
+    cmdData->type     = D3D11CmdType::BindSampler;
+    cmdData->stage    = stage;
+    cmdData->slot     = Slot;
+    cmdData->sampler  = std::move(sampler);
   }
 
 
@@ -3749,6 +3765,54 @@ namespace dxvk {
   }
 
 
+  template<typename ContextType>
+  template<DxbcProgramType ShaderStage>
+  void D3D11CommonContext<ContextType>::BindShaderResources(
+          UINT                              Slot,
+          UINT                              Count,
+    const Com<D3D11ShaderResourceView, false>* ppResources) {
+    using CmdData = D3D11CmdBindShaderResourcesData;
+
+    // Single bindings are much more compact as a plain command
+    if (Count == 1) {
+      BindShaderResource<ShaderStage>(Slot, ppResources[0].ptr());
+      return;
+    }
+
+    for (uint32_t i = 0; i < Count; i += CmdData::MaxCount) {
+      auto cmdData = EmitCsCmd<CmdData>(
+        [] (DxvkContext* ctx, CmdData* data) {
+          for (uint32_t j = 0; j < data->count; j++) {
+            if (data->bufferViews[j] != nullptr) {
+              ctx->bindResourceBufferView(data->stage, data->slot + j,
+                Forwarder::move(data->bufferViews[j]));
+            } else {
+              ctx->bindResourceImageView(data->stage, data->slot + j,
+                Forwarder::move(data->imageViews[j]));
+            }
+          }
+        });
+
+      cmdData->type   = D3D11CmdType::BindShaderResources;
+      cmdData->stage  = GetShaderStage(ShaderStage);
+      cmdData->slot   = Slot + i;
+      cmdData->count  = std::min(Count - i, CmdData::MaxCount);
+
+      for (uint32_t j = 0; j < cmdData->count; j++) {
+        auto view = ppResources[i + j].ptr();
+
+        if (!view)
+          continue;
+
+        if (view->GetViewInfo().Dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+          cmdData->imageViews[j] = view->GetImageView();
+        else
+          cmdData->bufferViews[j] = view->GetBufferView();
+      }
+    }
+  }
+
+
   template<typename ContextType>
   template<DxbcProgramType ShaderStage>
   void D3D11CommonContext<ContextType>::BindUnorderedAccessView(
@@ -4698,8 +4762,8 @@ namespace dxvk {
     const auto& bindings = m_state.srv[Stage];
     uint32_t slotId = computeSrvBinding(Stage, 0);
 
-    for (uint32_t i = 0; i < bindings.maxCount; i++)
-      BindShaderResource<Stage>(slotId + i, bindings.views[i].ptr());
+    if (bindings.maxCount)
+      BindShaderResources<Stage>(slotId, bindings.maxCount, bindings.views.data());
   }
 
 
@@ -4833,6 +4897,10 @@ namespace dxvk {
     auto& bindings = m_state.srv[ShaderStage];
     uint32_t slotId = computeSrvBinding(ShaderStage, StartSlot);
 
+    // Bind consecutive changed slots with a single command
+    uint32_t dirtyIndex = 0;
+    uint32_t dirtyCount = 0;
+
     for (uint32_t i = 0; i < NumResources; i++) {
       auto resView = static_cast<D3D11ShaderResourceView*>(ppResources[i]);
 
@@ -4850,10 +4918,26 @@ namespace dxvk {
         }
 
         bindings.views[StartSlot + i] = resView;
-        BindShaderResource<ShaderStage>(slotId + i, resView);
+
+        if (dirtyCount && dirtyIndex + dirtyCount == i) {
+          dirtyCount += 1;
+        } else {
+          if (dirtyCount) {
+            BindShaderResources<ShaderStage>(slotId + dirtyIndex,
+              dirtyCount, &bindings.views[StartSlot + dirtyIndex]);
+          }
+
+          dirtyIndex = i;
+          dirtyCount = 1;
+        }
       }
     }
 
+    if (dirtyCount) {
+      BindShaderResources<ShaderStage>(slotId + dirtyIndex,
+        dirtyCount, &bindings.views[StartSlot + dirtyIndex]);
+    }
+
     bindings.maxCount = std::clamp(StartSlot + NumResources,
       bindings.maxCount, uint32_t(bindings.views.size()));
   }
@@ -5090,6 +5174,18 @@ namespace dxvk {
     const void*                             pSrcData) {
     constexpr uint32_t MaxDirectUpdateSize = 64u;
 
+    if constexpr (!IsDeferred) {
+      // If the buffer is mapped and neither pending CS commands nor the
+      // GPU currently access it, we can write the data on the calling
+      // thread and skip both the staging allocation and the GPU copy.
+      if (pDstBuffer->HasSequenceNumber() && pDstBuffer->GetMapPtr()
+       && GetTypedContext()->m_csThread.lastSequenceNumber() >= pDstBuffer->GetSequenceNumber()
+       && !pDstBuffer->GetBuffer()->isInUse(DxvkAccess::Read)) {
+        std::memcpy(reinterpret_cast<char*>(pDstBuffer->GetMapPtr()) + Offset, pSrcData, Length);
+        return;
+      }
+    }
+
     DxvkBufferSlice bufferSlice = pDstBuffer->GetBufferSlice(Offset, Length);
 
     if (Length <= MaxDirectUpdateSize && !((Offset | Length) & 0x3)) {
@@ -877,6 +877,12 @@ namespace dxvk {
             UINT                              Slot,
             D3D11ShaderResourceView*          pResource);
 
+    template<DxbcProgramType ShaderStage>
+    void BindShaderResources(
+            UINT                              Slot,
+            UINT                              Count,
+      const Com<D3D11ShaderResourceView, false>* ppResources);
+
     template<DxbcProgramType ShaderStage>
     void BindUnorderedAccessView(
             UINT                              UavSlot,
@@ -233,9 +233,14 @@ namespace dxvk {
     // number of pending draw calls is high enough.
     ConsiderFlush(GpuFlushType::ImplicitWeakHint);
 
+    // Any resource used by the command list must have been created
+    // before this call, so flushing init commands once up front is
+    // sufficient and avoids taking the initializer lock per chunk.
+    m_parent->FlushInitCommands();
+
     // Dispatch command list to the CS thread
     commandList->EmitToCsThread([this] (DxvkCsChunkRef&& chunk, GpuFlushType flushType) {
-      EmitCsChunk(std::move(chunk));
+      m_csSeqNum = m_csThread.dispatchChunk(std::move(chunk));
 
       // Return the sequence number from before the flush since
       // that is actually going to be needed for resource tracking
@@ -873,6 +878,8 @@ namespace dxvk {
       if (cTracker && cTracker->needsAutoMarkers())
         ctx->endLatencyTracking(cTracker);
     });
+
+    UpdateFlushHeuristic();
   }
 
 
@@ -980,6 +987,24 @@ namespace dxvk {
   }
 
 
+  void D3D11ImmediateContext::UpdateFlushHeuristic() {
+    auto now = dxvk::high_resolution_clock::now();
+    auto counters = m_device->getStatCounters();
+
+    if (m_frameStartTime != dxvk::high_resolution_clock::time_point()) {
+      auto diff = counters.diff(m_frameStatCounters);
+      auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(now - m_frameStartTime);
+
+      m_flushTracker.notifyFrame(frameTime.count(),
+        diff.getCtr(DxvkStatCounter::GpuIdleTicks),
+        diff.getCtr(DxvkStatCounter::CsSyncTicks));
+    }
+
+    m_frameStartTime = now;
+    m_frameStatCounters = counters;
+  }
+
+
   void D3D11ImmediateContext::ExecuteFlush(
           GpuFlushType                FlushType,
           HANDLE                      hEvent,
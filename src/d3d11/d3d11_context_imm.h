@@ -126,6 +126,9 @@ namespace dxvk {
     uint64_t                m_flushSeqNum = 0ull;
     GpuFlushTracker         m_flushTracker;
 
+    dxvk::high_resolution_clock::time_point m_frameStartTime = { };
+    DxvkStatCounters        m_frameStatCounters;
+
     Rc<sync::Fence>         m_stagingBufferFence;
 
     VkDeviceSize            m_discardMemoryCounter = 0u;
@@ -201,6 +204,8 @@ namespace dxvk {
             HANDLE                      hEvent,
             BOOL                        Synchronize);
 
+    void UpdateFlushHeuristic();
+
     void ThrottleAllocation();
 
     void ThrottleDiscard(
@@ -93,39 +93,60 @@ namespace dxvk {
     const void*               pShaderBytecode,
           size_t              BytecodeLength,
           D3D11CommonShader*  pShader) {
-    // Use the shader's unique key for the lookup
+    // Use the shader's unique key for the lookup. If another thread
+    // is already compiling the same shader, wait for it to finish
+    // rather than translating the same shader multiple times.
     { std::unique_lock<dxvk::mutex> lock(m_mutex);
-      
+
+      m_cond.wait(lock, [this, pShaderKey] {
+        return m_pending.find(*pShaderKey) == m_pending.end();
+      });
+
       auto entry = m_modules.find(*pShaderKey);
       if (entry != m_modules.end()) {
         *pShader = entry->second;
         return S_OK;
       }
+
+      m_pending.insert(*pShaderKey);
     }
     
     // This shader has not been compiled yet, so we have to create a
     // new module. This takes a while, so we won't lock the structure.
     D3D11CommonShader module;
+    HRESULT hr = S_OK;
     
     try {
       module = D3D11CommonShader(pDevice, pShaderKey,
         pDxbcModuleInfo, pShaderBytecode, BytecodeLength);
     } catch (const DxvkError& e) {
       Logger::err(e.message());
-      return E_INVALIDARG;
+      hr = E_INVALIDARG;
+    } catch (...) {
+      // Make sure threads waiting for this shader do not hang
+      { std::unique_lock<dxvk::mutex> lock(m_mutex);
+        m_pending.erase(*pShaderKey);
+      }
+
+      m_cond.notify_all();
+      throw;
     }
     
-    // Insert the new module into the lookup table. If another thread
-    // has compiled the same shader in the meantime, we should return
-    // that object instead and discard the newly created module.
+    // Insert the new module into the lookup table and wake up any
+    // threads waiting for it. On failure, waiting threads will try
+    // to compile the shader themselves and report the error.
     { std::unique_lock<dxvk::mutex> lock(m_mutex);
-      
-      auto status = m_modules.insert({ *pShaderKey, module });
-      if (!status.second) {
-        *pShader = status.first->second;
-        return S_OK;
-      }
+
+      if (SUCCEEDED(hr))
+        m_modules.insert({ *pShaderKey, module });
+
+      m_pending.erase(*pShaderKey);
     }
+
+    m_cond.notify_all();
+
+    if (FAILED(hr))
+      return hr;
     
     *pShader = std::move(module);
     return S_OK;
@@ -2,6 +2,7 @@
 
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "../dxbc/dxbc_module.h"
 #include "../dxvk/dxvk_device.h"
@@ -192,11 +193,16 @@ namespace dxvk {
   private:
     
     dxvk::mutex m_mutex;
+    dxvk::condition_variable m_cond;
     
     std::unordered_map<
       DxvkShaderKey,
       D3D11CommonShader,
       DxvkHash, DxvkEq> m_modules;
+
+    std::unordered_set<
+      DxvkShaderKey,
+      DxvkHash, DxvkEq> m_pending;
     
   };
   
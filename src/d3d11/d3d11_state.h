@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <unordered_map>
 
 #include "d3d11_blend.h"
@@ -38,10 +39,16 @@ namespace dxvk {
    * an object with the same description already exists
    * and returns it if that is the case. This class
    * implements that behaviour.
+   *
+   * Objects are distributed across multiple independently
+   * locked shards based on the description hash, so that
+   * threads looking up different descriptions do not
+   * serialize on a single lock.
    */
   template<typename T>
   class D3D11StateObjectSet {
     using DescType = typename T::DescType;
+    constexpr static size_t ShardCount = 16;
   public:
     
     /**
@@ -54,14 +61,16 @@ namespace dxvk {
      * \returns Pointer to the state object
      */
     T* Create(D3D11Device* device, const DescType& desc) {
-      std::lock_guard<dxvk::mutex> lock(m_mutex);
+      auto& shard = m_shards[D3D11StateDescHash()(desc) % ShardCount];
+
+      std::lock_guard<dxvk::mutex> lock(shard.mutex);
       
-      auto entry = m_objects.find(desc);
+      auto entry = shard.objects.find(desc);
       
-      if (entry != m_objects.end())
+      if (entry != shard.objects.end())
         return ref(&entry->second);
       
-      auto result = m_objects.emplace(
+      auto result = shard.objects.emplace(
         std::piecewise_construct,
         std::tuple(desc),
         std::tuple(device, desc));
@@ -70,9 +79,13 @@ namespace dxvk {
     
   private:
     
-    dxvk::mutex                                m_mutex;
-    std::unordered_map<DescType, T,
-      D3D11StateDescHash, D3D11StateDescEqual> m_objects;
+    struct alignas(CACHE_LINE_SIZE) Shard {
+      dxvk::mutex                                mutex;
+      std::unordered_map<DescType, T,
+        D3D11StateDescHash, D3D11StateDescEqual> objects;
+    };
+
+    std::array<Shard, ShardCount> m_shards;
     
   };
   
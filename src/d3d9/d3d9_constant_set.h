@@ -42,6 +42,12 @@ namespace dxvk {
   struct D3D9SwvpConstantBuffers {
     D3D9ConstantBuffer        intBuffer;
     D3D9ConstantBuffer        boolBuffer;
+
+    // Float, int and bool constants live in separate buffers
+    // with SWVP, so track which ones actually need an upload.
+    bool                      floatDirty = true;
+    bool                      intDirty   = true;
+    bool                      boolDirty  = true;
   };
 
   struct D3D9ConstantSets {
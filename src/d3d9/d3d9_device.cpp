@@ -150,6 +150,8 @@ namespace dxvk {
 
     CreateConstantBuffers();
 
+    m_ffModules.LoadShaderKeys(this);
+
     m_availableMemory = DetermineInitialTextureMemory();
 
     m_hazardLayout = dxvkDevice->features().extAttachmentFeedbackLoopLayout.attachmentFeedbackLoopLayout
@@ -201,6 +203,8 @@ namespace dxvk {
     if (this_thread::isInModuleDetachment())
       return;
 
+    m_ffModules.StopLoading();
+
     Flush();
     SynchronizeCsThread(DxvkCsThread::SynchronizeAll);
 
@@ -3368,16 +3372,25 @@ namespace dxvk {
     bool oldCopies = oldShader && oldShader->GetMeta().needsConstantCopies;
     bool newCopies = newShader && newShader->GetMeta().needsConstantCopies;
 
-    m_consts[DxsoProgramTypes::VertexShader].dirty |= oldCopies || newCopies || !oldShader;
-    m_consts[DxsoProgramTypes::VertexShader].meta  = newShader ? newShader->GetMeta() : DxsoShaderMetaInfo();
+    D3D9ConstantSets& constSet = m_consts[DxsoProgramTypes::VertexShader];
+
+    bool dirtyF = oldCopies || newCopies || !oldShader;
+    bool dirtyI = !oldShader;
+    bool dirtyB = !oldShader;
 
     if (newShader && oldShader) {
-      m_consts[DxsoProgramTypes::VertexShader].dirty
-        |= newShader->GetMeta().maxConstIndexF > oldShader->GetMeta().maxConstIndexF
-        || newShader->GetMeta().maxConstIndexI > oldShader->GetMeta().maxConstIndexI
-        || newShader->GetMeta().maxConstIndexB > oldShader->GetMeta().maxConstIndexB;
+      dirtyF |= newShader->GetMeta().maxConstIndexF > oldShader->GetMeta().maxConstIndexF;
+      dirtyI |= newShader->GetMeta().maxConstIndexI > oldShader->GetMeta().maxConstIndexI;
+      dirtyB |= newShader->GetMeta().maxConstIndexB > oldShader->GetMeta().maxConstIndexB;
     }
 
+    constSet.dirty |= dirtyF || dirtyI || dirtyB;
+    constSet.meta   = newShader ? newShader->GetMeta() : DxsoShaderMetaInfo();
+
+    constSet.swvp.floatDirty |= dirtyF;
+    constSet.swvp.intDirty   |= dirtyI;
+    constSet.swvp.boolDirty  |= dirtyB;
+
     m_state.vertexShader = shader;
 
     if (shader != nullptr) {
@@ -4588,14 +4601,23 @@ namespace dxvk {
   D3D9BufferSlice D3D9DeviceEx::AllocUPBuffer(VkDeviceSize size) {
     constexpr VkDeviceSize UPBufferSize = 1 << 20;
 
-    if (unlikely(m_upBuffer == nullptr || size > UPBufferSize)) {
+    // Grow the buffer for large draws rather than creating a
+    // temporary buffer for every single one of them
+    constexpr VkDeviceSize MaxUPBufferSize = 16 << 20;
+
+    if (unlikely(m_upBuffer == nullptr || size > m_upBufferSize)) {
+      VkDeviceSize bufferSize = std::max(UPBufferSize, m_upBufferSize);
+
+      while (bufferSize < size)
+        bufferSize *= 2;
+
       VkMemoryPropertyFlags memoryFlags
         = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
         | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
         | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
       DxvkBufferCreateInfo info;
-      info.size   = std::max(UPBufferSize, size);
+      info.size   = bufferSize <= MaxUPBufferSize ? bufferSize : size;
       info.usage  = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
                   | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
       info.access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
@@ -4606,9 +4628,11 @@ namespace dxvk {
       Rc<DxvkBuffer> buffer = m_dxvkDevice->createBuffer(info, memoryFlags);
       void* mapPtr = buffer->mapPtr(0);
 
-      if (size <= UPBufferSize) {
+      if (bufferSize <= MaxUPBufferSize) {
         m_upBuffer = std::move(buffer);
+        m_upBufferOffset = 0;
         m_upBufferMapPtr = mapPtr;
+        m_upBufferSize = bufferSize;
       } else {
         // Temporary buffer
         D3D9BufferSlice result;
@@ -4620,7 +4644,7 @@ namespace dxvk {
 
     VkDeviceSize alignedSize = align(size, CACHE_LINE_SIZE);
 
-    if (unlikely(m_upBufferOffset + alignedSize > UPBufferSize)) {
+    if (unlikely(m_upBufferOffset + alignedSize > m_upBufferSize)) {
       auto slice = m_upBuffer->allocateStorage();
 
       m_upBufferOffset = 0;
@@ -5696,6 +5720,24 @@ namespace dxvk {
   }
 
 
+  void D3D9DeviceEx::UpdateFlushHeuristic() {
+    auto now = dxvk::high_resolution_clock::now();
+    auto counters = m_dxvkDevice->getStatCounters();
+
+    if (m_frameStartTime != dxvk::high_resolution_clock::time_point()) {
+      auto diff = counters.diff(m_frameStatCounters);
+      auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(now - m_frameStartTime);
+
+      m_flushTracker.notifyFrame(frameTime.count(),
+        diff.getCtr(DxvkStatCounter::GpuIdleTicks),
+        diff.getCtr(DxvkStatCounter::CsSyncTicks));
+    }
+
+    m_frameStartTime = now;
+    m_frameStatCounters = counters;
+  }
+
+
   void D3D9DeviceEx::SynchronizeCsThread(uint64_t SequenceNumber) {
     D3D9DeviceLock lock = LockDevice();
 
@@ -5865,7 +5907,7 @@ namespace dxvk {
 
     // Max copy source size is 8192 * 16 => always aligned to any plausible value
     // => we won't copy out of bounds
-    if (likely(constSet.meta.maxConstIndexF != 0)) {
+    if (likely(constSet.meta.maxConstIndexF != 0 && constSet.swvp.floatDirty)) {
       auto mapPtr = CopySoftwareConstants(constSet.buffer, Src.fConsts, floatDataSize);
 
       if (constSet.meta.needsConstantCopies) {
@@ -5884,11 +5926,15 @@ namespace dxvk {
 
     // Max copy source size is 2048 * 16 => always aligned to any plausible value
     // => we won't copy out of bounds
-    if (likely(constSet.meta.maxConstIndexI != 0))
+    if (likely(constSet.meta.maxConstIndexI != 0 && constSet.swvp.intDirty))
       CopySoftwareConstants(constSet.swvp.intBuffer, Src.iConsts, intDataSize);
 
-    if (likely(constSet.meta.maxConstIndexB != 0))
+    if (likely(constSet.meta.maxConstIndexB != 0 && constSet.swvp.boolDirty))
       CopySoftwareConstants(constSet.swvp.boolBuffer, Src.bConsts, boolDataSize);
+
+    constSet.swvp.floatDirty = false;
+    constSet.swvp.intDirty   = false;
+    constSet.swvp.boolDirty  = false;
   }
 
 
@@ -6147,6 +6193,8 @@ namespace dxvk {
       if (cTracker && cTracker->needsAutoMarkers())
         ctx->endLatencyTracking(cTracker);
     });
+
+    UpdateFlushHeuristic();
   }
 
 
@@ -7654,6 +7702,7 @@ namespace dxvk {
     m_state.vsConsts->bConsts[idx] |= bits & mask;
 
     m_consts[DxsoProgramTypes::VertexShader].dirty = true;
+    m_consts[DxsoProgramTypes::VertexShader].swvp.boolDirty = true;
   }
 
 
@@ -7729,15 +7778,44 @@ namespace dxvk {
       }
     }
 
+    if constexpr (ConstantType != D3D9ConstantType::Bool) {
+      // Many applications set the entire constant range for every draw
+      // even if most of it did not change. Skip redundant updates so
+      // that we don't have to upload the constant buffer again.
+      auto IsRedundant = [&] (const auto& set) {
+        if constexpr (ConstantType == D3D9ConstantType::Float)
+          return !std::memcmp(set->fConsts[StartRegister].data, pConstantData, Count * sizeof(Vector4));
+        else
+          return !std::memcmp(set->iConsts[StartRegister].data, pConstantData, Count * sizeof(Vector4i));
+      };
+
+      bool isRedundant = ProgramType == DxsoProgramType::VertexShader
+        ? IsRedundant(m_state.vsConsts)
+        : IsRedundant(m_state.psConsts);
+
+      if (isRedundant)
+        return D3D_OK;
+    }
+
     if constexpr (ConstantType != D3D9ConstantType::Bool) {
       uint32_t maxCount = ConstantType == D3D9ConstantType::Float
         ? m_consts[ProgramType].meta.maxConstIndexF
         : m_consts[ProgramType].meta.maxConstIndexI;
 
-      m_consts[ProgramType].dirty |= StartRegister < maxCount;
+      bool dirty = StartRegister < maxCount;
+      m_consts[ProgramType].dirty |= dirty;
+
+      if constexpr (ProgramType == DxsoProgramType::VertexShader) {
+        if constexpr (ConstantType == D3D9ConstantType::Float)
+          m_consts[ProgramType].swvp.floatDirty |= dirty;
+        else
+          m_consts[ProgramType].swvp.intDirty |= dirty;
+      }
     } else if constexpr (ProgramType == DxsoProgramType::VertexShader) {
       if (unlikely(CanSWVP())) {
-        m_consts[DxsoProgramType::VertexShader].dirty |= StartRegister < m_consts[ProgramType].meta.maxConstIndexB;
+        bool dirty = StartRegister < m_consts[ProgramType].meta.maxConstIndexB;
+        m_consts[DxsoProgramType::VertexShader].dirty |= dirty;
+        m_consts[DxsoProgramType::VertexShader].swvp.boolDirty |= dirty;
       }
     }
 
@@ -974,6 +974,8 @@ namespace dxvk {
 
     void ConsiderFlush(GpuFlushType FlushType);
 
+    void UpdateFlushHeuristic();
+
     bool ChangeReportedMemory(int64_t delta) {
       if (IsExtended())
         return true;
@@ -1434,6 +1436,7 @@ namespace dxvk {
 
     Rc<DxvkBuffer>                  m_upBuffer;
     VkDeviceSize                    m_upBufferOffset  = 0ull;
+    VkDeviceSize                    m_upBufferSize    = 0ull;
     void*                           m_upBufferMapPtr  = nullptr;
 
     DxvkStagingBuffer               m_stagingBuffer;
@@ -1549,6 +1552,9 @@ namespace dxvk {
     uint64_t                        m_flushSeqNum = 0ull;
     GpuFlushTracker                 m_flushTracker;
 
+    dxvk::high_resolution_clock::time_point m_frameStartTime = { };
+    DxvkStatCounters                m_frameStatCounters;
+
     std::atomic<int64_t>            m_availableMemory = { 0 };
 
     D3D9DeviceLostState             m_deviceLostState          = D3D9DeviceLostState::Ok;
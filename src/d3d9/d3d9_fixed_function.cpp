@@ -9,6 +9,7 @@
 #include "../spirv/spirv_module.h"
 
 #include <cfloat>
+#include <filesystem>
 
 namespace dxvk {
 
@@ -2547,37 +2548,342 @@ namespace dxvk {
   }
 
 
-  D3D9FFShader D3D9FFShaderModuleSet::GetShaderModule(
+  static uint32_t ComputeShaderKeyLayoutHash() {
+    DxvkHashState hash;
+
+    // Set each bit field to all ones in an otherwise default key and
+    // hash the resulting data, so that adding, removing, reordering or
+    // resizing any field changes the hash in practice.
+    uint32_t ones = ~0u;
+
+    auto addData = [&hash] (const uint32_t* pData, size_t Count) {
+      for (size_t i = 0; i < Count; i++)
+        hash.add(pData[i]);
+    };
+
+    #define ADD_VS_FIELD(Field) { \
+      D3D9FFShaderKeyVS key; \
+      key.Data.Contents.Field = ones; \
+      addData(key.Data.Primitive, std::size(key.Data.Primitive)); }
+
+    ADD_VS_FIELD(TexcoordIndices);
+    ADD_VS_FIELD(HasPositionT);
+    ADD_VS_FIELD(HasColor0);
+    ADD_VS_FIELD(HasColor1);
+    ADD_VS_FIELD(HasPointSize);
+    ADD_VS_FIELD(UseLighting);
+    ADD_VS_FIELD(NormalizeNormals);
+    ADD_VS_FIELD(LocalViewer);
+    ADD_VS_FIELD(RangeFog);
+    ADD_VS_FIELD(TexcoordFlags);
+    ADD_VS_FIELD(DiffuseSource);
+    ADD_VS_FIELD(AmbientSource);
+    ADD_VS_FIELD(SpecularSource);
+    ADD_VS_FIELD(EmissiveSource);
+    ADD_VS_FIELD(TransformFlags);
+    ADD_VS_FIELD(LightCount);
+    ADD_VS_FIELD(TexcoordDeclMask);
+    ADD_VS_FIELD(HasFog);
+    ADD_VS_FIELD(VertexBlendMode);
+    ADD_VS_FIELD(VertexBlendIndexed);
+    ADD_VS_FIELD(VertexBlendCount);
+    ADD_VS_FIELD(VertexClipping);
+    ADD_VS_FIELD(Projected);
+
+    #undef ADD_VS_FIELD
+
+    // All texture stages share the same layout
+    #define ADD_FS_FIELD(Field) { \
+      D3D9FFShaderKeyFS key; \
+      key.Stages[0].Contents.Field = ones; \
+      addData(key.Stages[0].Primitive, std::size(key.Stages[0].Primitive)); }
+
+    ADD_FS_FIELD(ColorOp);
+    ADD_FS_FIELD(ColorArg0);
+    ADD_FS_FIELD(ColorArg1);
+    ADD_FS_FIELD(ColorArg2);
+    ADD_FS_FIELD(AlphaOp);
+    ADD_FS_FIELD(AlphaArg0);
+    ADD_FS_FIELD(AlphaArg1);
+    ADD_FS_FIELD(AlphaArg2);
+    ADD_FS_FIELD(Type);
+    ADD_FS_FIELD(ResultIsTemp);
+    ADD_FS_FIELD(Projected);
+    ADD_FS_FIELD(ProjectedCount);
+    ADD_FS_FIELD(SampleDref);
+    ADD_FS_FIELD(TextureBound);
+    ADD_FS_FIELD(GlobalSpecularEnable);
+
+    #undef ADD_FS_FIELD
+
+    return uint32_t(size_t(hash));
+  }
+
+
+  D3D9FFShaderModuleSet::~D3D9FFShaderModuleSet() {
+    StopLoading();
+  }
+
+
+  static void WriteShaderKey(
+          std::ofstream&        File,
+          VkShaderStageFlagBits Stage,
+    const void*                 pKey,
+          size_t                KeySize) {
+    // Write each entry with a single call. This makes it less likely
+    // for entries from multiple processes to get interleaved, but is
+    // not guaranteed to prevent it; entries with an invalid stage make
+    // the file get rewritten on the next load.
+    std::vector<char> data(sizeof(uint32_t) + KeySize);
+
+    uint32_t stage = uint32_t(Stage);
+    std::memcpy(&data[0], &stage, sizeof(stage));
+    std::memcpy(&data[sizeof(stage)], pKey, KeySize);
+
+    File.write(data.data(), data.size());
+    File.flush();
+  }
+
+
+  void D3D9FFShaderModuleSet::LoadShaderKeys(
+          D3D9DeviceEx*         pDevice) {
+    std::string useStateCache = env::getEnvVar("DXVK_STATE_CACHE");
+
+    if (useStateCache == "0" || useStateCache == "disable"
+     || !pDevice->GetDXVKDevice()->config().enableStateCache)
+      return;
+
+    std::string dir = env::getEnvVar("DXVK_STATE_CACHE_PATH");
+    std::string path = dir;
+
+    if (!path.empty() && *path.rbegin() != '/')
+      path += '/';
+
+    path += env::getExeBaseName() + ".dxvk-ffcache";
+
+    str::path_string fileName = str::topath(path.c_str());
+
+    // Read all keys stored in the file. If the file is missing, outdated,
+    // contains invalid or duplicate entries or exceeds the key limit, it
+    // gets rewritten with the keys that we actually use.
+    D3D9FFShaderKeyFileHeader expected;
+    expected.layoutHash = ComputeShaderKeyLayoutHash();
+
+    std::vector<D3D9FFShaderKeyVS> vsKeys;
+    std::vector<D3D9FFShaderKeyFS> fsKeys;
+
+    bool recreateFile = true;
+
+    if (useStateCache != "reset") {
+      std::ifstream file(fileName.c_str(), std::ios_base::binary);
+      D3D9FFShaderKeyFileHeader header;
+
+      if (file.read(reinterpret_cast<char*>(&header), sizeof(header))
+       && !std::memcmp(&header, &expected, sizeof(header))) {
+        uint32_t stage = 0;
+        recreateFile = false;
+
+        while (file.read(reinterpret_cast<char*>(&stage), sizeof(stage))) {
+          if (m_vsKeysInFile.size() + m_fsKeysInFile.size() >= MaxCachedKeys) {
+            Logger::warn(str::format("D3D9: Fixed-function shader cache exceeds ", MaxCachedKeys, " entries"));
+            recreateFile = true;
+            break;
+          }
+
+          if (stage == VK_SHADER_STAGE_VERTEX_BIT) {
+            D3D9FFShaderKeyVS key;
+
+            if (!file.read(reinterpret_cast<char*>(&key), sizeof(key))) {
+              recreateFile = true;
+              break;
+            }
+
+            if (m_vsKeysInFile.insert(key).second)
+              vsKeys.push_back(key);
+            else
+              recreateFile = true;
+          } else if (stage == VK_SHADER_STAGE_FRAGMENT_BIT) {
+            D3D9FFShaderKeyFS key;
+
+            if (!file.read(reinterpret_cast<char*>(&key), sizeof(key))) {
+              recreateFile = true;
+              break;
+            }
+
+            if (m_fsKeysInFile.insert(key).second)
+              fsKeys.push_back(key);
+            else
+              recreateFile = true;
+          } else {
+            recreateFile = true;
+            break;
+          }
+        }
+      }
+    }
+
+    if (!recreateFile || RecreateKeyFile(dir, fileName, expected, vsKeys, fsKeys)) {
+      m_keyFile = std::ofstream(fileName.c_str(),
+        std::ios_base::binary | std::ios_base::app);
+    }
+
+    // Create shaders on a separate thread so that device creation
+    // does not stall. Shaders that are needed before the thread gets
+    // to them will be created on demand as usual.
+    if (!vsKeys.empty() || !fsKeys.empty()) {
+      m_loader = dxvk::thread([
+        this, pDevice,
+        cVsKeys = std::move(vsKeys),
+        cFsKeys = std::move(fsKeys)
+      ] {
+        env::setThreadName("dxvk-ffcache");
+        CreateCachedShaders(pDevice, cVsKeys, cFsKeys);
+      });
+    }
+  }
+
+
+  void D3D9FFShaderModuleSet::StopLoading() {
+    if (!m_loader.joinable())
+      return;
+
+    m_stopLoading.store(true);
+    m_loader.join();
+  }
+
+
+  bool D3D9FFShaderModuleSet::RecreateKeyFile(
+    const std::string&                    Directory,
+    const str::path_string&               FileName,
+    const D3D9FFShaderKeyFileHeader&      Header,
+    const std::vector<D3D9FFShaderKeyVS>& VsKeys,
+    const std::vector<D3D9FFShaderKeyFS>& FsKeys) {
+    // Write the new file to a temporary location and then replace the
+    // old one, so that other processes appending to the same file
+    // never observe a truncated or partially written file.
+    str::path_string tempName = FileName + str::topath(".tmp");
+
+    { std::ofstream file(tempName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+      if (!file && !Directory.empty() && env::createDirectory(Directory))
+        file = std::ofstream(tempName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+      if (!file)
+        return false;
+
+      file.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+      for (const auto& key : VsKeys)
+        WriteShaderKey(file, VK_SHADER_STAGE_VERTEX_BIT, &key, sizeof(key));
+
+      for (const auto& key : FsKeys)
+        WriteShaderKey(file, VK_SHADER_STAGE_FRAGMENT_BIT, &key, sizeof(key));
+
+      if (!file)
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempName, FileName, ec);
+
+    if (ec) {
+      Logger::warn("D3D9: Failed to replace fixed-function shader cache file");
+      return false;
+    }
+
+    return true;
+  }
+
+
+  void D3D9FFShaderModuleSet::CreateCachedShaders(
+          D3D9DeviceEx*                   pDevice,
+    const std::vector<D3D9FFShaderKeyVS>& VsKeys,
+    const std::vector<D3D9FFShaderKeyFS>& FsKeys) {
+    try {
+      for (size_t i = 0; i < VsKeys.size() && !m_stopLoading.load(); i++)
+        GetOrCreateShader(pDevice, VK_SHADER_STAGE_VERTEX_BIT, VsKeys[i], m_vsModules, m_vsPending, m_vsKeysInFile);
+
+      for (size_t i = 0; i < FsKeys.size() && !m_stopLoading.load(); i++)
+        GetOrCreateShader(pDevice, VK_SHADER_STAGE_FRAGMENT_BIT, FsKeys[i], m_fsModules, m_fsPending, m_fsKeysInFile);
+    } catch (const DxvkError& e) {
+      Logger::err(e.message());
+      return;
+    }
+
+    Logger::info(str::format("D3D9: Created ", GetVSCount(), " fixed-function vertex shaders and ",
+      GetFSCount(), " fixed-function pixel shaders from cache"));
+  }
+
+
+  template<typename KeyType, typename MapType, typename SetType>
+  D3D9FFShader D3D9FFShaderModuleSet::GetOrCreateShader(
           D3D9DeviceEx*         pDevice,
-    const D3D9FFShaderKeyVS&    ShaderKey) {
-    // Use the shader's unique key for the lookup
-    auto entry = m_vsModules.find(ShaderKey);
-    if (entry != m_vsModules.end())
-      return entry->second;
-    
-    D3D9FFShader shader(
-      pDevice, ShaderKey);
+          VkShaderStageFlagBits Stage,
+    const KeyType&              Key,
+          MapType&              Modules,
+          SetType&              Pending,
+          SetType&              KeysInFile) {
+    // Use the shader's unique key for the lookup. If another thread
+    // is already creating the same shader, wait for it to finish
+    // rather than compiling the same shader twice.
+    { std::unique_lock<dxvk::mutex> lock(m_mutex);
+
+      m_cond.wait(lock, [&Key, &Pending] {
+        return Pending.find(Key) == Pending.end();
+      });
+
+      auto entry = Modules.find(Key);
+      if (entry != Modules.end())
+        return entry->second;
+
+      Pending.insert(Key);
+    }
+
+    // Create the shader without holding the lock so that other
+    // threads can keep looking up shaders in the meantime
+    try {
+      D3D9FFShader shader(pDevice, Key);
 
-    m_vsModules.insert({ShaderKey, shader});
+      { std::lock_guard<dxvk::mutex> lock(m_mutex);
 
-    return shader;
+        Modules.insert({ Key, shader });
+        Pending.erase(Key);
+
+        // Only record keys that are not already in the file, and
+        // stop recording once the file has reached the key limit
+        if (m_keyFile.is_open() && KeysInFile.find(Key) == KeysInFile.end()
+         && m_vsKeysInFile.size() + m_fsKeysInFile.size() < MaxCachedKeys) {
+          WriteShaderKey(m_keyFile, Stage, &Key, sizeof(Key));
+          KeysInFile.insert(Key);
+        }
+      }
+
+      m_cond.notify_all();
+      return shader;
+    } catch (...) {
+      { std::lock_guard<dxvk::mutex> lock(m_mutex);
+        Pending.erase(Key);
+      }
+
+      m_cond.notify_all();
+      throw;
+    }
   }
 
 
   D3D9FFShader D3D9FFShaderModuleSet::GetShaderModule(
           D3D9DeviceEx*         pDevice,
-    const D3D9FFShaderKeyFS&    ShaderKey) {
-    // Use the shader's unique key for the lookup
-    auto entry = m_fsModules.find(ShaderKey);
-    if (entry != m_fsModules.end())
-      return entry->second;
-    
-    D3D9FFShader shader(
-      pDevice, ShaderKey);
+    const D3D9FFShaderKeyVS&    ShaderKey) {
+    return GetOrCreateShader(pDevice, VK_SHADER_STAGE_VERTEX_BIT,
+      ShaderKey, m_vsModules, m_vsPending, m_vsKeysInFile);
+  }
 
-    m_fsModules.insert({ShaderKey, shader});
 
-    return shader;
+  D3D9FFShader D3D9FFShaderModuleSet::GetShaderModule(
+          D3D9DeviceEx*         pDevice,
+    const D3D9FFShaderKeyFS&    ShaderKey) {
+    return GetOrCreateShader(pDevice, VK_SHADER_STAGE_FRAGMENT_BIT,
+      ShaderKey, m_fsModules, m_fsPending, m_fsKeysInFile);
   }
 
 
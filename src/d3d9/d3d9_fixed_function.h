@@ -8,7 +8,11 @@
 
 #include "../dxso/dxso_isgn.h"
 
+#include <atomic>
+#include <fstream>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace dxvk {
 
@@ -240,10 +244,48 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Fixed-function shader key file header
+   *
+   * The version must be bumped whenever the meaning of any
+   * shader key bits changes. Changes to the bit field layout
+   * are detected automatically via the layout hash.
+   */
+  struct D3D9FFShaderKeyFileHeader {
+    char     magic[4]   = { 'D', 'X', 'F', 'F' };
+    uint32_t version    = 2;
+    uint32_t vsKeySize  = sizeof(D3D9FFShaderKeyVS);
+    uint32_t fsKeySize  = sizeof(D3D9FFShaderKeyFS);
+    uint32_t layoutHash = 0;
+  };
+
+
   class D3D9FFShaderModuleSet : public RcObject {
 
   public:
 
+    ~D3D9FFShaderModuleSet();
+
+    /**
+     * \brief Creates shaders for keys used in previous runs
+     *
+     * Fixed-function shader keys are recorded in a file next to
+     * the state cache, so that shaders can be created up front
+     * and the state cache can compile pipelines for them before
+     * they are first used. Newly encountered keys are appended.
+     * Shaders are created on a background thread.
+     * \param [in] pDevice The device
+     */
+    void LoadShaderKeys(
+            D3D9DeviceEx*         pDevice);
+
+    /**
+     * \brief Stops creating shaders for cached keys
+     *
+     * Must be called before the device gets destroyed.
+     */
+    void StopLoading();
+
     D3D9FFShader GetShaderModule(
             D3D9DeviceEx*         pDevice,
       const D3D9FFShaderKeyVS&    ShaderKey);
@@ -253,15 +295,24 @@ namespace dxvk {
       const D3D9FFShaderKeyFS&    ShaderKey);
 
     UINT GetVSCount() const {
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
       return m_vsModules.size();
     }
 
     UINT GetFSCount() const {
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
       return m_fsModules.size();
     }
 
   private:
 
+    // Limits the number of keys stored in the file, so that a large
+    // or stale file does not keep creating shaders nobody is going to use
+    static constexpr size_t MaxCachedKeys = 4096;
+
+    mutable dxvk::mutex       m_mutex;
+    dxvk::condition_variable  m_cond;
+
     std::unordered_map<
       D3D9FFShaderKeyVS,
       D3D9FFShader,
@@ -272,6 +323,48 @@ namespace dxvk {
       D3D9FFShader,
       D3D9FFShaderKeyHash, D3D9FFShaderKeyEq> m_fsModules;
 
+    std::unordered_set<
+      D3D9FFShaderKeyVS,
+      D3D9FFShaderKeyHash, D3D9FFShaderKeyEq> m_vsPending;
+
+    std::unordered_set<
+      D3D9FFShaderKeyFS,
+      D3D9FFShaderKeyHash, D3D9FFShaderKeyEq> m_fsPending;
+
+    std::unordered_set<
+      D3D9FFShaderKeyVS,
+      D3D9FFShaderKeyHash, D3D9FFShaderKeyEq> m_vsKeysInFile;
+
+    std::unordered_set<
+      D3D9FFShaderKeyFS,
+      D3D9FFShaderKeyHash, D3D9FFShaderKeyEq> m_fsKeysInFile;
+
+    std::ofstream m_keyFile;
+
+    std::atomic<bool> m_stopLoading = { false };
+    dxvk::thread      m_loader;
+
+    void CreateCachedShaders(
+            D3D9DeviceEx*                   pDevice,
+      const std::vector<D3D9FFShaderKeyVS>& VsKeys,
+      const std::vector<D3D9FFShaderKeyFS>& FsKeys);
+
+    template<typename KeyType, typename MapType, typename SetType>
+    D3D9FFShader GetOrCreateShader(
+            D3D9DeviceEx*         pDevice,
+            VkShaderStageFlagBits Stage,
+      const KeyType&              Key,
+            MapType&              Modules,
+            SetType&              Pending,
+            SetType&              KeysInFile);
+
+    bool RecreateKeyFile(
+      const std::string&                    Directory,
+      const str::path_string&               FileName,
+      const D3D9FFShaderKeyFileHeader&      Header,
+      const std::vector<D3D9FFShaderKeyVS>& VsKeys,
+      const std::vector<D3D9FFShaderKeyFS>& FsKeys);
+
   };
 
 
@@ -184,6 +184,46 @@ namespace dxvk {
       Capture
     };
 
+    /**
+     * \brief Iterates over runs of consecutive set bits
+     *
+     * Invokes the callback once per run with the index of
+     * the first bit and the number of bits in the run, so
+     * that contiguous constants can be set in one call.
+     */
+    template <typename BitSet, typename Fn>
+    static void ForEachBitRange(const BitSet& bits, Fn&& fn) {
+      uint32_t start = 0;
+      uint32_t count = 0;
+
+      for (uint32_t i = 0; i < bits.dwordCount(); i++) {
+        uint32_t mask = bits.dword(i);
+
+        while (mask) {
+          uint32_t first  = bit::tzcnt(mask);
+          uint32_t length = bit::tzcnt(~(mask >> first));
+          uint32_t idx    = i * 32 + first;
+
+          if (count && start + count == idx) {
+            count += length;
+          } else {
+            if (count)
+              fn(start, count);
+
+            start = idx;
+            count = length;
+          }
+
+          mask = first + length < 32
+            ? mask & (~0u << (first + length))
+            : 0u;
+        }
+      }
+
+      if (count)
+        fn(start, count);
+    }
+
     template <typename Dst, typename Src, bool IgnoreStreamOffset>
     void ApplyOrCapture(Dst* dst, const Src* src) {
       if (m_captures.flags.test(D3D9CapturedStateFlag::StreamFreq)) {
@@ -273,21 +313,13 @@ namespace dxvk {
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::VsConstants)) {
-        for (uint32_t i = 0; i < m_captures.vsConsts.fConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.vsConsts.fConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
+        ForEachBitRange(m_captures.vsConsts.fConsts, [&] (uint32_t idx, uint32_t count) {
+          dst->SetVertexShaderConstantF(idx, (float*)&src->vsConsts->fConsts[idx], count);
+        });
 
-            dst->SetVertexShaderConstantF(idx, (float*)&src->vsConsts->fConsts[idx], 1);
-          }
-        }
-
-        for (uint32_t i = 0; i < m_captures.vsConsts.iConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.vsConsts.iConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
-
-            dst->SetVertexShaderConstantI(idx, (int*)&src->vsConsts->iConsts[idx], 1);
-          }
-        }
+        ForEachBitRange(m_captures.vsConsts.iConsts, [&] (uint32_t idx, uint32_t count) {
+          dst->SetVertexShaderConstantI(idx, (int*)&src->vsConsts->iConsts[idx], count);
+        });
 
         if (m_captures.vsConsts.bConsts.any()) {
           for (uint32_t i = 0; i < m_captures.vsConsts.bConsts.dwordCount(); i++)
@@ -296,21 +328,13 @@ namespace dxvk {
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::PsConstants)) {
-        for (uint32_t i = 0; i < m_captures.psConsts.fConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.psConsts.fConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
-
-            dst->SetPixelShaderConstantF(idx, (float*)&src->psConsts->fConsts[idx], 1);
-          }
-        }
-
-        for (uint32_t i = 0; i < m_captures.psConsts.iConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.psConsts.iConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
+        ForEachBitRange(m_captures.psConsts.fConsts, [&] (uint32_t idx, uint32_t count) {
+          dst->SetPixelShaderConstantF(idx, (float*)&src->psConsts->fConsts[idx], count);
+        });
 
-            dst->SetPixelShaderConstantI(idx, (int*)&src->psConsts->iConsts[idx], 1);
-          }
-        }
+        ForEachBitRange(m_captures.psConsts.iConsts, [&] (uint32_t idx, uint32_t count) {
+          dst->SetPixelShaderConstantI(idx, (int*)&src->psConsts->iConsts[idx], count);
+        });
 
         if (m_captures.psConsts.bConsts.any()) {
           for (uint32_t i = 0; i < m_captures.psConsts.bConsts.dwordCount(); i++)
@@ -2526,6 +2526,18 @@ namespace dxvk {
     value.type.ccount = 1;
     
     uint32_t typeId = getVectorTypeId(value.type);
+
+    // Compute shaders commonly use append and consume buffers from all
+    // invocations at once, so perform one atomic per subgroup instead.
+    // Fragment shaders are excluded since helper invocations would take
+    // part in the ballot, and the elected invocation may be one of them.
+    if (m_moduleInfo.options.useSubgroupOpsForAtomicCounters
+     && m_programInfo.type() == DxbcProgramType::ComputeShader) {
+      value.id = emitAtomicCounterSubgroup(ins, typeId, ptrId, scopeId, semanticsId);
+
+      emitRegisterStore(ins.dst[0], value);
+      return;
+    }
     
     switch (ins.op) {
       case DxbcOpcode::ImmAtomicAlloc:
@@ -2550,6 +2562,72 @@ namespace dxvk {
     // Store the result
     emitRegisterStore(ins.dst[0], value);
   }
+
+
+  uint32_t DxbcCompiler::emitAtomicCounterSubgroup(
+    const DxbcShaderInstruction&  ins,
+          uint32_t                typeId,
+          uint32_t                ptrId,
+          uint32_t                scopeId,
+          uint32_t                semanticsId) {
+    m_module.enableCapability(spv::CapabilityGroupNonUniform);
+    m_module.enableCapability(spv::CapabilityGroupNonUniformBallot);
+
+    uint32_t subgroupScopeId = m_module.constu32(spv::ScopeSubgroup);
+    uint32_t ballotTypeId = getVectorTypeId({ DxbcScalarType::Uint32, 4 });
+
+    // Count active invocations and compute the index of the
+    // current invocation among them
+    uint32_t ballotId = m_module.opGroupNonUniformBallot(
+      ballotTypeId, subgroupScopeId, m_module.constBool(true));
+
+    uint32_t countId = m_module.opGroupNonUniformBallotBitCount(
+      typeId, subgroupScopeId, spv::GroupOperationReduce, ballotId);
+    uint32_t indexId = m_module.opGroupNonUniformBallotBitCount(
+      typeId, subgroupScopeId, spv::GroupOperationExclusiveScan, ballotId);
+
+    // Only perform the atomic in the first active invocation
+    uint32_t electId = m_module.opGroupNonUniformElect(
+      m_module.defBoolType(), subgroupScopeId);
+
+    uint32_t labelAtomic = m_module.allocateId();
+    uint32_t labelSkip   = m_module.allocateId();
+    uint32_t labelEnd    = m_module.allocateId();
+
+    m_module.opSelectionMerge(labelEnd, spv::SelectionControlMaskNone);
+    m_module.opBranchConditional(electId, labelAtomic, labelSkip);
+
+    m_module.opLabel(labelAtomic);
+
+    uint32_t atomicId = ins.op == DxbcOpcode::ImmAtomicAlloc
+      ? m_module.opAtomicIAdd(typeId, ptrId, scopeId, semanticsId, countId)
+      : m_module.opAtomicISub(typeId, ptrId, scopeId, semanticsId, countId);
+
+    m_module.opBranch(labelEnd);
+    m_module.opLabel(labelSkip);
+    m_module.opBranch(labelEnd);
+    m_module.opLabel(labelEnd);
+
+    std::array<SpirvPhiLabel, 2> phiLabels = {{
+      { atomicId,                 labelAtomic },
+      { m_module.constu32(0),     labelSkip   },
+    }};
+
+    uint32_t baseId = m_module.opPhi(typeId,
+      phiLabels.size(), phiLabels.data());
+
+    // The elected invocation is the lowest active one, so
+    // broadcasting from the first one returns its result
+    baseId = m_module.opGroupNonUniformBroadcastFirst(
+      typeId, subgroupScopeId, baseId);
+
+    // Counter values returned by consume are post-decrement
+    if (ins.op == DxbcOpcode::ImmAtomicAlloc)
+      return m_module.opIAdd(typeId, baseId, indexId);
+
+    return m_module.opISub(typeId, baseId,
+      m_module.opIAdd(typeId, indexId, m_module.constu32(1)));
+  }
   
   
   void DxbcCompiler::emitBarrier(const DxbcShaderInstruction& ins) {
@@ -699,6 +699,13 @@ namespace dxvk {
     
     void emitAtomicCounter(
       const DxbcShaderInstruction&  ins);
+
+    uint32_t emitAtomicCounterSubgroup(
+      const DxbcShaderInstruction&  ins,
+            uint32_t                typeId,
+            uint32_t                ptrId,
+            uint32_t                scopeId,
+            uint32_t                semanticsId);
     
     void emitBarrier(
       const DxbcShaderInstruction&  ins);
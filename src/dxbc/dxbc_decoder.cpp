@@ -148,7 +148,7 @@ namespace dxvk {
     // Retrieve the instruction format in order to parse the
     // operands. Doing this mostly automatically means that
     // the compiler can rely on the operands being valid.
-    const DxbcInstFormat format = dxbcInstructionFormat(m_instruction.op);
+    const DxbcInstFormat& format = dxbcInstructionFormat(m_instruction.op);
     m_instruction.opClass = format.instructionClass;
     
     for (uint32_t i = 0; i < format.operandCount; i++)
@@ -1244,12 +1244,14 @@ namespace dxvk {
   }};
   
   
-  DxbcInstFormat dxbcInstructionFormat(DxbcOpcode opcode) {
+  const DxbcInstFormat& dxbcInstructionFormat(DxbcOpcode opcode) {
+    static const DxbcInstFormat s_undefinedFormat = { };
+
     const uint32_t idx = static_cast<uint32_t>(opcode);
-    
+
     return (idx < g_instructionFormats.size())
-      ? g_instructionFormats.at(idx)
-      : DxbcInstFormat();
+      ? g_instructionFormats[idx]
+      : s_undefinedFormat;
   }
   
 }
\ No newline at end of file
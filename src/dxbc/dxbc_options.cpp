@@ -26,6 +26,12 @@ namespace dxvk {
     supportsTypedUavLoadR32 = (r32Features & VK_FORMAT_FEATURE_2_STORAGE_READ_WITHOUT_FORMAT_BIT);
     supportsRawAccessChains = device->features().nvRawAccessChains.shaderRawAccessChains;
 
+    const VkSubgroupFeatureFlags subgroupOps = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_BALLOT_BIT;
+
+    useSubgroupOpsForAtomicCounters
+      =  (devInfo.vk11.subgroupSupportedStages & VK_SHADER_STAGE_COMPUTE_BIT)
+      && (devInfo.vk11.subgroupSupportedOperations & subgroupOps) == subgroupOps;
+
     switch (device->config().useRawSsbo) {
       case Tristate::Auto:  minSsboAlignment = devInfo.core.properties.limits.minStorageBufferOffsetAlignment; break;
       case Tristate::True:  minSsboAlignment =  4u; break;
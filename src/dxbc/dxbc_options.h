@@ -30,6 +30,10 @@ namespace dxvk {
     /// Determines whether raw access chains are supported
     bool supportsRawAccessChains = false;
 
+    /// Use subgroup operations to reduce the number of
+    /// atomic counter operations in compute shaders
+    bool useSubgroupOpsForAtomicCounters = false;
+
     /// Clear thread-group shared memory to zero
     bool zeroInitWorkgroupMemory = false;
 
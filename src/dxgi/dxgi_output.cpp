@@ -291,16 +291,29 @@ namespace dxvk {
       return S_OK;
     }
 
+    // Querying display modes from the system can be slow, and apps
+    // tend to enumerate modes many times, once per format and twice
+    // per call to query the size first, so only do this once. Output
+    // objects are created on enumeration, so the list stays current.
+    std::lock_guard<dxvk::mutex> lock(m_modeMutex);
+
+    if (!m_modeListValid) {
+      wsi::WsiMode devMode = { };
+      uint32_t srcModeId = 0;
+
+      while (wsi::getDisplayMode(m_monitor, srcModeId++, &devMode))
+        m_modeList.push_back(devMode);
+
+      m_modeListValid = true;
+    }
+
     // Walk over all modes that the display supports and
     // return those that match the requested format etc.
-    wsi::WsiMode devMode = { };
-    
-    uint32_t srcModeId = 0;
     uint32_t dstModeId = 0;
     
     std::vector<DXGI_MODE_DESC1> modeList;
     
-    while (wsi::getDisplayMode(m_monitor, srcModeId++, &devMode)) {
+    for (const auto& devMode : m_modeList) {
       // Only enumerate interlaced modes if requested.
       if (devMode.interlaced && !(Flags & DXGI_ENUM_MODES_INTERLACED))
         continue;
@@ -135,6 +135,10 @@ namespace dxvk {
 
     wsi::WsiDisplayMetadata m_metadata = {};
 
+    dxvk::mutex               m_modeMutex;
+    std::vector<wsi::WsiMode> m_modeList;
+    bool                      m_modeListValid = false;
+
     static void FilterModesByDesc(
             std::vector<DXGI_MODE_DESC1>& Modes,
       const DXGI_MODE_DESC1&              TargetMode);
@@ -160,6 +160,7 @@ namespace dxvk {
 
     DxvkAdapterQueueIndices queues;
     queues.graphics = graphicsQueue;
+    queues.compute = computeQueue;
     queues.transfer = transferQueue;
     queues.sparse = sparseQueue;
     return queues;
@@ -1360,6 +1361,7 @@ namespace dxvk {
   void DxvkAdapter::logQueueFamilies(const DxvkAdapterQueueIndices& queues) {
     Logger::info(str::format("Queue families:",
       "\n  Graphics : ", queues.graphics,
+      "\n  Compute  : ", queues.compute != queues.graphics ? str::format(queues.compute) : "n/a",
       "\n  Transfer : ", queues.transfer,
       "\n  Sparse   : ", queues.sparse != VK_QUEUE_FAMILY_IGNORED ? str::format(queues.sparse) : "n/a"));
   }
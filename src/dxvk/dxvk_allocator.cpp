@@ -275,22 +275,24 @@ namespace dxvk {
 
     // Do a binary search, but optimize for the common
     // case where we request a small page count
-    uint32_t lo = 0u;
-    uint32_t hi = m_freeList.size();
+    uint32_t size = m_freeList.size();
 
     if (count <= m_freeList.back().count)
-      return int32_t(hi);
-
-    while (lo < hi) {
-      uint32_t mid = (lo + hi) / 2u;
-
-      if (count <= m_freeList[mid].count)
-        lo = mid + 1;
-      else
-        hi = mid;
+      return int32_t(size);
+
+    // Branchless search, the comparison results are effectively
+    // random so the branchy version suffers from mispredictions.
+    // The result is always within [base, base + size].
+    const PageRange* data = m_freeList.data();
+    const PageRange* base = data;
+
+    while (size > 1u) {
+      uint32_t half = size / 2u;
+      base += (count <= base[half - 1u].count) ? half : 0u;
+      size -= half;
     }
 
-    return int32_t(lo);
+    return int32_t(base - data) + int32_t(count <= base->count);
   }
 
 
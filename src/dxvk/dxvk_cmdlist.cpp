@@ -109,6 +109,7 @@ namespace dxvk {
 
     VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
     poolInfo.queueFamilyIndex = queueFamily;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
 
     if (vk->vkCreateCommandPool(vk->device(), &poolInfo, nullptr, &m_commandPool))
       throw DxvkError("DxvkCommandPool: Failed to create command pool");
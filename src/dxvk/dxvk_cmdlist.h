@@ -271,6 +271,28 @@ namespace dxvk {
      * to split the command list into multiple submissions.
      */
     void next();
+
+    /**
+     * \brief Checks whether the current submission only binds memory
+     *
+     * If no commands have been recorded since the last sparse
+     * binding operation, subsequent sparse binds can be added
+     * to the same submission without changing the order of
+     * operations on the queue.
+     * \returns \c true if the current set of command buffers
+     *    is empty and sparse binding operations are pending
+     */
+    bool hasOnlySparseBinds() const {
+      if (!m_cmd.sparseBind || m_cmd.execCommands)
+        return false;
+
+      for (uint32_t i = 0; i < m_cmd.cmdBuffers.size(); i++) {
+        if (DxvkCmdBuffer(i) != DxvkCmdBuffer::ExecBuffer && m_cmd.cmdBuffers[i])
+          return false;
+      }
+
+      return true;
+    }
     
     /**
      * \brief Tracks an object
@@ -102,6 +102,7 @@ namespace dxvk {
   VkPipeline DxvkComputePipeline::createPipeline(
     const DxvkComputePipelineStateInfo& state) const {
     auto vk = m_device->vkd();
+    auto t0 = dxvk::high_resolution_clock::now();
 
     DxvkPipelineSpecConstantState scState(m_shaders.cs->getSpecConstantMask(), state.sc);
     
@@ -125,6 +126,10 @@ namespace dxvk {
       return VK_NULL_HANDLE;
     }
 
+    auto t1 = dxvk::high_resolution_clock::now();
+    m_stats->recordCompileTime("compute", m_debugName,
+      std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0));
+
     return pipeline;
   }
 
@@ -79,6 +79,9 @@ namespace dxvk {
     m_cmd = cmdList;
     m_cmd->init();
 
+    m_cmdTimings = m_device->hasCommandTimings()
+      ? &m_cmd->statCounters() : nullptr;
+
     if (m_descriptorPool == nullptr)
       m_descriptorPool = m_descriptorManager->getDescriptorPool();
 
@@ -90,12 +93,17 @@ namespace dxvk {
     this->endCurrentCommands();
     this->relocateQueuedResources();
 
+    // Cached sets may reference resources that are only
+    // kept alive by the command list we're submitting
+    m_descriptorSetCache.clear();
+
     if (m_descriptorPool->shouldSubmit(false)) {
       m_cmd->trackDescriptorPool(m_descriptorPool, m_descriptorManager);
       m_descriptorPool = m_descriptorManager->getDescriptorPool();
     }
 
     m_cmd->finalize();
+    m_cmdTimings = nullptr;
     return std::exchange(m_cmd, nullptr);
   }
 
@@ -107,6 +115,10 @@ namespace dxvk {
     }
 
     m_renderPassIndex = 0u;
+
+    m_relocationBudget.memory = 0u;
+    m_relocationBudget.submissions = 0u;
+    m_relocationBudget.hasFrames = true;
   }
 
 
@@ -555,14 +567,6 @@ namespace dxvk {
           VkImageSubresourceLayers srcSubresource,
           VkOffset3D            srcOffset,
           VkExtent3D            extent) {
-    this->spillRenderPass(true);
-
-    if (this->copyImageClear(dstImage, dstSubresource, dstOffset, extent, srcImage, srcSubresource))
-      return;
-
-    this->prepareImage(dstImage, vk::makeSubresourceRange(dstSubresource));
-    this->prepareImage(srcImage, vk::makeSubresourceRange(srcSubresource));
-
     bool useFb = dstSubresource.aspectMask != srcSubresource.aspectMask;
 
     if (m_device->perfHints().preferFbDepthStencilCopy) {
@@ -571,8 +575,31 @@ namespace dxvk {
             && (srcImage->info().usage & VK_IMAGE_USAGE_SAMPLED_BIT);
     }
 
+    // If neither image has been used in the current command list, we can
+    // perform the copy in the init command buffer without interrupting the
+    // render pass. Require the source image to be entirely unused as well,
+    // since two reads would otherwise both transition it out of its default
+    // layout in the same init barrier batch.
+    if (!useFb
+     && prepareOutOfOrderTransfer(srcImage, DxvkAccess::Write)
+     && prepareOutOfOrderTransfer(dstImage, DxvkAccess::Write)) {
+      this->copyImageHw(DxvkCmdBuffer::InitBuffer,
+        dstImage, dstSubresource, dstOffset,
+        srcImage, srcSubresource, srcOffset,
+        extent);
+      return;
+    }
+
+    this->spillRenderPass(true);
+
+    if (this->copyImageClear(dstImage, dstSubresource, dstOffset, extent, srcImage, srcSubresource))
+      return;
+
+    this->prepareImage(dstImage, vk::makeSubresourceRange(dstSubresource));
+    this->prepareImage(srcImage, vk::makeSubresourceRange(srcSubresource));
+
     if (!useFb) {
-      this->copyImageHw(
+      this->copyImageHw(DxvkCmdBuffer::ExecBuffer,
         dstImage, dstSubresource, dstOffset,
         srcImage, srcSubresource, srcOffset,
         extent);
@@ -1038,13 +1065,28 @@ namespace dxvk {
     const Rc<DxvkBuffer>&           buffer) {
     auto slice = buffer->getSliceHandle();
 
-    m_cmd->cmdFillBuffer(DxvkCmdBuffer::InitBuffer,
+    // The buffer is not in use by the GPU yet, so we can clear it on the
+    // transfer queue alongside regular resource uploads. This keeps large
+    // zero-initializations off the graphics queue during level loads.
+    m_cmd->cmdFillBuffer(DxvkCmdBuffer::SdmaBuffer,
       slice.handle, slice.offset,
       dxvk::align(slice.length, 4), 0);
 
-    accessMemory(DxvkCmdBuffer::InitBuffer,
-      VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
-      buffer->info().stages, buffer->info().access);
+    if (m_device->hasDedicatedTransferQueue()) {
+      // Same as resource uploads, buffers use concurrent sharing
+      // mode, so the semaphore wait is sufficient for ownership.
+      accessMemory(DxvkCmdBuffer::SdmaBuffer,
+        VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE);
+
+      accessMemory(DxvkCmdBuffer::InitBuffer,
+        VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+        buffer->info().stages, buffer->info().access);
+    } else {
+      accessMemory(DxvkCmdBuffer::SdmaBuffer,
+        VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        buffer->info().stages, buffer->info().access);
+    }
 
     m_cmd->track(buffer, DxvkAccess::Write);
   }
@@ -2375,9 +2417,11 @@ namespace dxvk {
   void DxvkContext::updatePageTable(
     const DxvkSparseBindInfo&   bindInfo,
           DxvkSparseBindFlags   flags) {
-    // Split command buffers here so that we execute
-    // the sparse binding operation at the right time
-    if (!flags.test(DxvkSparseBindFlag::SkipSynchronization))
+    // Split command buffers here so that we execute the sparse binding
+    // operation at the right time. If nothing has been recorded since
+    // the previous page table update, batch both into one submission.
+    if (!flags.test(DxvkSparseBindFlag::SkipSynchronization)
+     && !m_cmd->hasOnlySparseBinds())
       this->splitCommands();
 
     DxvkSparsePageAllocator* srcAllocator = bindInfo.srcAllocator.ptr();
@@ -3698,6 +3742,7 @@ namespace dxvk {
 
   
   void DxvkContext::copyImageHw(
+          DxvkCmdBuffer         cmdBuffer,
     const Rc<DxvkImage>&        dstImage,
           VkImageSubresourceLayers dstSubresource,
           VkOffset3D            dstOffset,
@@ -3710,8 +3755,10 @@ namespace dxvk {
 
     auto dstFormatInfo = dstImage->formatInfo();
 
-    flushPendingAccesses(*dstImage, dstSubresourceRange, DxvkAccess::Write);
-    flushPendingAccesses(*srcImage, srcSubresourceRange, DxvkAccess::Read);
+    if (cmdBuffer == DxvkCmdBuffer::ExecBuffer) {
+      flushPendingAccesses(*dstImage, dstSubresourceRange, DxvkAccess::Write);
+      flushPendingAccesses(*srcImage, srcSubresourceRange, DxvkAccess::Read);
+    }
 
     VkImageLayout dstImageLayout = dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
     VkImageLayout srcImageLayout = srcImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
@@ -3721,7 +3768,7 @@ namespace dxvk {
       dstImage->isFullSubresource(dstSubresource, extent));
     addImageLayoutTransition(*srcImage, srcSubresourceRange, srcImageLayout,
       VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, false);
-    flushImageLayoutTransitions(DxvkCmdBuffer::ExecBuffer);
+    flushImageLayoutTransitions(cmdBuffer);
 
     for (auto aspects = dstSubresource.aspectMask; aspects; ) {
       auto aspect = vk::getNextAspect(aspects);
@@ -3753,14 +3800,14 @@ namespace dxvk {
       copyInfo.regionCount = 1;
       copyInfo.pRegions = &copyRegion;
 
-      m_cmd->cmdCopyImage(DxvkCmdBuffer::ExecBuffer, &copyInfo);
+      m_cmd->cmdCopyImage(cmdBuffer, &copyInfo);
     }
 
-    accessImage(DxvkCmdBuffer::ExecBuffer,
+    accessImage(cmdBuffer,
       *dstImage, dstSubresourceRange, dstImageLayout,
       VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
 
-    accessImage(DxvkCmdBuffer::ExecBuffer,
+    accessImage(cmdBuffer,
       *srcImage, srcSubresourceRange, srcImageLayout,
       VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
 
@@ -5131,6 +5178,8 @@ namespace dxvk {
   
   
   bool DxvkContext::updateGraphicsPipeline() {
+    DxvkStatTimer timer(m_cmdTimings, DxvkStatCounter::CmdPipelineTicks);
+
     if (unlikely(m_state.cp.pipeline != nullptr))
       this->unbindComputePipeline();
 
@@ -5313,15 +5362,25 @@ namespace dxvk {
     auto& scInfo  = BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS ? m_state.gp.state.sc  : m_state.cp.state.sc;
     auto& scState = BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS ? m_state.gp.constants : m_state.cp.constants;
 
-    for (auto i : bit::BitMask(scState.mask))
+    // Constants may have been changed and reset between draws,
+    // only look up a new pipeline if any value actually changed
+    bool changed = false;
+
+    for (auto i : bit::BitMask(scState.mask)) {
+      changed |= scInfo.specConstants[i] != scState.data[i];
       scInfo.specConstants[i] = scState.data[i];
+    }
 
     if (BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS) {
       m_flags.clr(DxvkContextFlag::GpDirtySpecConstants);
-      m_flags.set(DxvkContextFlag::GpDirtyPipelineState);
+
+      if (changed)
+        m_flags.set(DxvkContextFlag::GpDirtyPipelineState);
     } else {
       m_flags.clr(DxvkContextFlag::CpDirtySpecConstants);
-      m_flags.set(DxvkContextFlag::CpDirtyPipelineState);
+
+      if (changed)
+        m_flags.set(DxvkContextFlag::CpDirtyPipelineState);
     }
   }
 
@@ -5334,6 +5393,8 @@ namespace dxvk {
   
   template<VkPipelineBindPoint BindPoint>
   void DxvkContext::updateResourceBindings(const DxvkBindingLayoutObjects* layout) {
+    DxvkStatTimer timer(m_cmdTimings, DxvkStatCounter::CmdBindingTicks);
+
     const auto& bindings = layout->layout();
 
     // Ensure that the arrays we write descriptor info to are big enough
@@ -5355,25 +5416,26 @@ namespace dxvk {
     dirtySetMask &= layoutSetMask;
 
     std::array<VkDescriptorSet, DxvkDescriptorSets::SetCount> sets;
-    m_descriptorPool->alloc(layout, dirtySetMask, sets.data());
 
     uint32_t descriptorCount = 0;
 
     for (auto setIndex : bit::BitMask(dirtySetMask)) {
       uint32_t bindingCount = bindings.getBindingCount(setIndex);
-      VkDescriptorSet set = sets[setIndex];
+      uint32_t setStart = descriptorCount;
 
       for (uint32_t j = 0; j < bindingCount; j++) {
         const auto& binding = bindings.getBinding(setIndex, j);
 
         if (!useDescriptorTemplates) {
           auto& descriptorWrite = m_descriptorWrites[descriptorCount];
-          descriptorWrite.dstSet = set;
           descriptorWrite.dstBinding = j;
           descriptorWrite.descriptorType = binding.descriptorType;
         }
 
+        // Zero-initialize so that the descriptor set cache can
+        // compare the raw data regardless of descriptor type
         auto& descriptorInfo = m_descriptors[descriptorCount++];
+        descriptorInfo = DxvkDescriptorInfo();
 
         switch (binding.descriptorType) {
           case VK_DESCRIPTOR_TYPE_SAMPLER: {
@@ -5516,17 +5578,38 @@ namespace dxvk {
         }
       }
 
-      if (useDescriptorTemplates) {
-        m_cmd->updateDescriptorSetWithTemplate(set,
-          layout->getSetUpdateTemplate(setIndex),
-          &m_descriptors[0]);
-        descriptorCount = 0;
+      // Reuse a previously written set with identical contents
+      // if possible, otherwise allocate and write a new one.
+      VkDescriptorSetLayout setLayout = layout->getSetLayout(setIndex);
+      VkDescriptorSet set = m_descriptorSetCache.find(setLayout,
+        bindingCount, &m_descriptors[setStart]);
+
+      if (set) {
+        descriptorCount = setStart;
+      } else {
+        m_descriptorPool->alloc(layout, 1u << setIndex, sets.data());
+        set = sets[setIndex];
+
+        m_descriptorSetCache.insert(setLayout,
+          bindingCount, &m_descriptors[setStart], set);
+
+        if (useDescriptorTemplates) {
+          m_cmd->updateDescriptorSetWithTemplate(set,
+            layout->getSetUpdateTemplate(setIndex),
+            &m_descriptors[0]);
+          descriptorCount = 0;
+        } else {
+          for (uint32_t j = setStart; j < descriptorCount; j++)
+            m_descriptorWrites[j].dstSet = set;
+        }
       }
 
+      sets[setIndex] = set;
+
       // If the next set is not dirty, update and bind all previously
       // updated sets in one go in order to reduce api call overhead.
       if (!(((dirtySetMask >> 1) >> setIndex) & 1u)) {
-        if (!useDescriptorTemplates) {
+        if (!useDescriptorTemplates && descriptorCount) {
           m_cmd->updateDescriptorSets(descriptorCount,
             m_descriptorWrites.data());
           descriptorCount = 0;
@@ -5793,9 +5876,16 @@ namespace dxvk {
   
   
   void DxvkContext::updateVertexBufferBindings() {
+    DxvkStatTimer timer(m_cmdTimings, DxvkStatCounter::CmdVertexBufferTicks);
+
+    bool fullUpdate = m_flags.test(DxvkContextFlag::GpDirtyVertexBuffers);
+    uint32_t dirtyMask = std::exchange(m_state.vi.dirtyMask, 0u);
+
     m_flags.clr(DxvkContextFlag::GpDirtyVertexBuffers);
 
-    if (unlikely(!m_state.gp.state.il.bindingCount()))
+    uint32_t bindingCount = m_state.gp.state.il.bindingCount();
+
+    if (unlikely(!bindingCount))
       return;
     
     std::array<VkBuffer,     MaxNumVertexBindings> buffers;
@@ -5806,8 +5896,47 @@ namespace dxvk {
     bool oldDynamicStrides = m_flags.test(DxvkContextFlag::GpDynamicVertexStrides);
     bool newDynamicStrides = true;
 
-    // Set buffer handles and offsets for active bindings
-    for (uint32_t i = 0; i < m_state.gp.state.il.bindingCount(); i++) {
+    // Gather strides for all active bindings first since we need
+    // to know whether we can use dynamic strides in any case
+    for (uint32_t i = 0; i < bindingCount; i++) {
+      uint32_t binding = m_state.gp.state.ilBindings[i].binding();
+
+      strides[i] = m_state.vi.vertexBuffers[binding].length()
+        ? m_state.vi.vertexStrides[binding] : 0u;
+
+      // Dynamic strides are only allowed if the stride is not smaller
+      // than highest attribute offset + format size for given binding
+      if (strides[i])
+        newDynamicStrides &= strides[i] >= m_state.vi.vertexExtents[i];
+    }
+
+    // If only some vertex buffers were rebound since the last update,
+    // only rebind the range of bindings that actually changed. Buffers
+    // outside of that range remain bound and tracked by the command
+    // list. Switching stride modes requires rebinding everything.
+    uint32_t first = 0u;
+    uint32_t count = bindingCount;
+
+    if (!fullUpdate && oldDynamicStrides == newDynamicStrides) {
+      uint32_t end = 0u;
+      first = bindingCount;
+
+      for (uint32_t i = 0; i < bindingCount; i++) {
+        if (dirtyMask & (1u << m_state.gp.state.ilBindings[i].binding())) {
+          first = std::min(first, i);
+          end = i + 1;
+        }
+      }
+
+      // Changed bindings are not used by the current input layout
+      if (end <= first)
+        return;
+
+      count = end - first;
+    }
+
+    // Set buffer handles and offsets for bindings in the given range
+    for (uint32_t i = first; i < first + count; i++) {
       uint32_t binding = m_state.gp.state.ilBindings[i].binding();
       
       if (likely(m_state.vi.vertexBuffers[binding].length())) {
@@ -5816,20 +5945,12 @@ namespace dxvk {
         buffers[i] = vbo.buffer.buffer;
         offsets[i] = vbo.buffer.offset;
         lengths[i] = vbo.buffer.range;
-        strides[i] = m_state.vi.vertexStrides[binding];
-
-        if (strides[i]) {
-          // Dynamic strides are only allowed if the stride is not smaller
-          // than highest attribute offset + format size for given binding
-          newDynamicStrides &= strides[i] >= m_state.vi.vertexExtents[i];
-        }
 
         m_cmd->track(m_state.vi.vertexBuffers[binding].buffer(), DxvkAccess::Read);
       } else {
         buffers[i] = VK_NULL_HANDLE;
         offsets[i] = 0;
         lengths[i] = 0;
-        strides[i] = 0;
       }
     }
 
@@ -5839,7 +5960,7 @@ namespace dxvk {
     if (unlikely(!oldDynamicStrides) || unlikely(!newDynamicStrides)) {
       m_flags.clr(DxvkContextFlag::GpDynamicVertexStrides);
 
-      for (uint32_t i = 0; i < m_state.gp.state.il.bindingCount(); i++) {
+      for (uint32_t i = 0; i < bindingCount; i++) {
         uint32_t stride = newDynamicStrides ? 0 : strides[i];
 
         if (m_state.gp.state.ilBindings[i].stride() != stride) {
@@ -5854,9 +5975,9 @@ namespace dxvk {
 
     // Vertex bindigs get remapped when compiling the
     // pipeline, so this actually does the right thing
-    m_cmd->cmdBindVertexBuffers(0, m_state.gp.state.il.bindingCount(),
-      buffers.data(), offsets.data(), lengths.data(),
-      newDynamicStrides ? strides.data() : nullptr);
+    m_cmd->cmdBindVertexBuffers(first, count,
+      &buffers[first], &offsets[first], &lengths[first],
+      newDynamicStrides ? &strides[first] : nullptr);
   }
   
   
@@ -6118,7 +6239,7 @@ namespace dxvk {
         return false;
     }
     
-    if (m_flags.test(DxvkContextFlag::GpDirtyVertexBuffers))
+    if (m_flags.test(DxvkContextFlag::GpDirtyVertexBuffers) || m_state.vi.dirtyMask)
       this->updateVertexBufferBindings();
     
     if (m_flags.test(DxvkContextFlag::GpDirtySpecConstants))
@@ -6221,6 +6342,8 @@ namespace dxvk {
     if (m_barrierControl.test(DxvkBarrierControl::IgnoreGraphicsBarriers))
       return;
 
+    DxvkStatTimer timer(m_cmdTimings, DxvkStatCounter::CmdBarrierTicks);
+
     constexpr auto storageBufferAccess = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFORM_FEEDBACK_WRITE_BIT_EXT;
     constexpr auto storageImageAccess  = VK_ACCESS_SHADER_WRITE_BIT;
 
@@ -6257,7 +6380,7 @@ namespace dxvk {
     }
 
     // Same here, also ignore unused vertex bindings
-    if (m_flags.test(DxvkContextFlag::GpDirtyVertexBuffers)) {
+    if (m_flags.test(DxvkContextFlag::GpDirtyVertexBuffers) || m_state.vi.dirtyMask) {
       uint32_t bindingCount = m_state.gp.state.il.bindingCount();
 
       for (uint32_t i = 0; i < bindingCount && !requiresBarrier; i++) {
@@ -6766,8 +6889,25 @@ namespace dxvk {
     constexpr static uint32_t MaxRelocationsPerSubmission = 128u;
     constexpr static uint32_t MaxRelocatedMemoryPerSubmission = 16u << 20;
 
-    auto resourceList = m_common->memoryManager().pollRelocationList(
-      MaxRelocationsPerSubmission, MaxRelocatedMemoryPerSubmission);
+    // Also limit the amount of memory moved per frame, so that applications
+    // submitting many command lists per frame do not end up copying large
+    // amounts of memory at once. Defragmentation is not urgent and can be
+    // spread out over multiple frames. Applications that never present
+    // will refill the budget after a number of submissions instead.
+    constexpr static uint32_t MaxRelocatedMemoryPerFrame = 48u << 20;
+    constexpr static uint32_t MaxSubmissionsPerFrame = 16u;
+
+    if (!m_relocationBudget.hasFrames
+     && ++m_relocationBudget.submissions > MaxSubmissionsPerFrame) {
+      m_relocationBudget.memory = 0u;
+      m_relocationBudget.submissions = 0u;
+    }
+
+    if (m_relocationBudget.memory >= MaxRelocatedMemoryPerFrame)
+      return;
+
+    auto resourceList = m_common->memoryManager().pollRelocationList(MaxRelocationsPerSubmission,
+      std::min<VkDeviceSize>(MaxRelocatedMemoryPerSubmission, MaxRelocatedMemoryPerFrame - m_relocationBudget.memory));
 
     if (resourceList.empty())
       return;
@@ -6789,6 +6929,8 @@ namespace dxvk {
       if (!storage)
         continue;
 
+      m_relocationBudget.memory += storage->getMemoryInfo().size;
+
       Rc<DxvkImage> image = dynamic_cast<DxvkImage*>(e.resource.ptr());
       Rc<DxvkBuffer> buffer = dynamic_cast<DxvkBuffer*>(e.resource.ptr());
 
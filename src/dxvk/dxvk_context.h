@@ -386,7 +386,7 @@ namespace dxvk {
             uint32_t              stride) {
       m_state.vi.vertexBuffers[binding] = std::move(buffer);
       m_state.vi.vertexStrides[binding] = stride;
-      m_flags.set(DxvkContextFlag::GpDirtyVertexBuffers);
+      m_state.vi.dirtyMask |= 1u << binding;
     }
 
     /**
@@ -405,7 +405,7 @@ namespace dxvk {
             uint32_t              stride) {
       m_state.vi.vertexBuffers[binding].setRange(offset, length);
       m_state.vi.vertexStrides[binding] = stride;
-      m_flags.set(DxvkContextFlag::GpDirtyVertexBuffers);
+      m_state.vi.dirtyMask |= 1u << binding;
     }
 
     /**
@@ -910,6 +910,7 @@ namespace dxvk {
      *
      * Clears the given buffer to zero. Only safe to call
      * if the buffer is not currently in use by the GPU.
+     * Like uploads, this may execute on the transfer queue.
      * \param [in] buffer Buffer to clear
      */
     void initBuffer(
@@ -1405,10 +1406,18 @@ namespace dxvk {
 
     uint64_t                m_trackingId = 0u;
     uint32_t                m_renderPassIndex = 0u;
+
+    struct {
+      VkDeviceSize          memory = 0u;
+      uint32_t              submissions = 0u;
+      bool                  hasFrames = false;
+    } m_relocationBudget;
     
     Rc<DxvkCommandList>     m_cmd;
     Rc<DxvkBuffer>          m_zeroBuffer;
 
+    DxvkStatCounters*       m_cmdTimings = nullptr;
+
     DxvkContextFlags        m_flags;
     DxvkContextState        m_state;
     DxvkContextFeatures     m_features;
@@ -1416,6 +1425,7 @@ namespace dxvk {
 
     Rc<DxvkDescriptorPool>  m_descriptorPool;
     Rc<DxvkDescriptorManager> m_descriptorManager;
+    DxvkDescriptorSetCache  m_descriptorSetCache;
 
     DxvkBarrierBatch        m_sdmaAcquires;
     DxvkBarrierBatch        m_sdmaBarriers;
@@ -1532,6 +1542,7 @@ namespace dxvk {
             VkClearValue          value);
     
     void copyImageHw(
+            DxvkCmdBuffer         cmdBuffer,
       const Rc<DxvkImage>&        dstImage,
             VkImageSubresourceLayers dstSubresource,
             VkOffset3D            dstOffset,
@@ -19,24 +19,10 @@ namespace dxvk {
 
   void DxvkCsChunk::executeAll(DxvkContext* ctx) {
     auto cmd = m_head;
-    
-    if (m_flags.test(DxvkCsChunkFlag::SingleUse)) {
-      m_commandOffset = 0;
-      
-      while (cmd != nullptr) {
-        auto next = cmd->next();
-        cmd->exec(ctx);
-        cmd->~DxvkCsCmd();
-        cmd = next;
-      }
 
-      m_head = nullptr;
-      m_tail = nullptr;
-    } else {
-      while (cmd != nullptr) {
-        cmd->exec(ctx);
-        cmd = cmd->next();
-      }
+    while (cmd != nullptr) {
+      cmd->exec(ctx);
+      cmd = cmd->next();
     }
   }
   
@@ -63,6 +49,11 @@ namespace dxvk {
   
   
   DxvkCsChunkPool::~DxvkCsChunkPool() {
+    for (auto& shard : m_shards) {
+      for (DxvkCsChunk* chunk : shard.chunks)
+        delete chunk;
+    }
+
     for (DxvkCsChunk* chunk : m_chunks)
       delete chunk;
   }
@@ -71,11 +62,25 @@ namespace dxvk {
   DxvkCsChunk* DxvkCsChunkPool::allocChunk(DxvkCsChunkFlags flags) {
     DxvkCsChunk* chunk = nullptr;
 
-    { std::lock_guard<dxvk::mutex> lock(m_mutex);
-      
-      if (m_chunks.size() != 0) {
-        chunk = m_chunks.back();
-        m_chunks.pop_back();
+    auto& shard = getShard();
+
+    { std::lock_guard<sync::Spinlock> shardLock(shard.mutex);
+
+      if (shard.chunks.empty()) {
+        // Refill the local cache with a batch of chunks
+        // so that we don't hit the global lock every time
+        std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+        size_t count = std::min(m_chunks.size(), BatchSize);
+
+        shard.chunks.insert(shard.chunks.end(),
+          m_chunks.end() - count, m_chunks.end());
+        m_chunks.resize(m_chunks.size() - count);
+      }
+
+      if (!shard.chunks.empty()) {
+        chunk = shard.chunks.back();
+        shard.chunks.pop_back();
       }
     }
     
@@ -90,8 +95,27 @@ namespace dxvk {
   void DxvkCsChunkPool::freeChunk(DxvkCsChunk* chunk) {
     chunk->reset();
     
-    std::lock_guard<dxvk::mutex> lock(m_mutex);
-    m_chunks.push_back(chunk);
+    auto& shard = getShard();
+
+    std::lock_guard<sync::Spinlock> shardLock(shard.mutex);
+    shard.chunks.push_back(chunk);
+
+    if (shard.chunks.size() >= 2u * BatchSize) {
+      // Chunks are often freed on a different thread than
+      // they get allocated on, return them in batches.
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+      m_chunks.insert(m_chunks.end(),
+        shard.chunks.end() - BatchSize, shard.chunks.end());
+      shard.chunks.resize(shard.chunks.size() - BatchSize);
+    }
+  }
+
+
+  DxvkCsChunkPool::Shard& DxvkCsChunkPool::getShard() {
+    uint32_t threadId = uint32_t(dxvk::this_thread::get_id());
+    uint32_t index = (threadId * 0x9e3779b1u) >> (32u - ShardCountLog2);
+    return m_shards[index];
   }
   
   
@@ -99,7 +123,8 @@ namespace dxvk {
     const Rc<DxvkDevice>&   device,
     const Rc<DxvkContext>&  context)
   : m_device(device), m_context(context),
-    m_thread([this] { threadFunc(); }) {
+    m_thread([this] { threadFunc(); }),
+    m_retireThread([this] { retireFunc(); }) {
     
   }
   
@@ -111,46 +136,43 @@ namespace dxvk {
     
     m_condOnAdd.notify_one();
     m_thread.join();
+
+    // The CS thread may have retired more chunks
+    // before exiting, make sure those get freed.
+    { std::unique_lock<dxvk::mutex> lock(m_retireMutex);
+      m_retireStopped = true;
+    }
+
+    m_retireCond.notify_one();
+    m_retireThread.join();
   }
   
   
   uint64_t DxvkCsThread::dispatchChunk(DxvkCsChunkRef&& chunk) {
-    uint64_t seq;
-
-    { std::unique_lock<dxvk::mutex> lock(m_mutex);
-      seq = ++m_queueOrdered.seqDispatch;
-
-      auto& entry = m_queueOrdered.queue.emplace_back();
-      entry.chunk = std::move(chunk);
-      entry.seq = seq;
-
-      m_condOnAdd.notify_one();
-    }
-    
-    return seq;
+    return pushOrdered(std::move(chunk), true);
   }
 
 
   void DxvkCsThread::injectChunk(DxvkCsQueue queue, DxvkCsChunkRef&& chunk, bool synchronize) {
     uint64_t timeline = 0u;
 
-    { std::unique_lock<dxvk::mutex> lock(m_mutex);
-      auto& q = getQueue(queue);
+    if (queue == DxvkCsQueue::Ordered) {
+      timeline = pushOrdered(std::move(chunk), synchronize);
+    } else {
+      std::unique_lock<dxvk::mutex> lock(m_mutex);
 
       if (synchronize)
-        timeline = ++q.seqDispatch;
+        timeline = ++m_queueHighPrio.seqDispatch;
 
-      auto& entry = q.queue.emplace_back();
+      auto& entry = m_queueHighPrio.queue.emplace_back();
       entry.chunk = std::move(chunk);
       entry.seq = timeline;
 
       m_condOnAdd.notify_one();
 
-      if (queue == DxvkCsQueue::HighPriority) {
-        // Worker will check this flag after executing any
-        // chunk without causing additional lock contention
-        m_hasHighPrio.store(true, std::memory_order_release);
-      }
+      // Worker will check this flag after executing any
+      // chunk without causing additional lock contention
+      m_hasHighPrio.store(true, std::memory_order_release);
     }
 
     if (synchronize) {
@@ -171,7 +193,7 @@ namespace dxvk {
       // happens while another thread is submitting then there is
       // an inherent race anyway
       if (seq == SynchronizeAll)
-        seq = m_queueOrdered.seqDispatch;
+        seq = m_seqDispatch.load(std::memory_order_acquire);
 
       auto t0 = dxvk::high_resolution_clock::now();
 
@@ -188,74 +210,162 @@ namespace dxvk {
       m_device->addStatCtr(DxvkStatCounter::CsSyncTicks, ticks.count());
     }
   }
+
+
+  uint64_t DxvkCsThread::pushOrdered(
+          DxvkCsChunkRef&&  chunk,
+          bool              timeline) {
+    DxvkCsQueuedChunk entry;
+    entry.chunk = std::move(chunk);
+
+    uint64_t seq = 0u;
+
+    { std::unique_lock<sync::Spinlock> lock(m_producerLock);
+
+      while (true) {
+        if (timeline)
+          seq = m_seqDispatch.load(std::memory_order_relaxed) + 1u;
+
+        entry.seq = seq;
+
+        if (likely(m_queueOrdered.push(entry)))
+          break;
+
+        // The CS thread is far behind, drop the lock so that other
+        // producers are not stuck spinning and wait for it to catch up
+        lock.unlock();
+
+        bool hasSpace = sync::spinFor(SpinCount, [this] {
+          return !m_queueOrdered.full();
+        });
+
+        if (!hasSpace) {
+          std::unique_lock<dxvk::mutex> waitLock(m_mutex);
+          m_producersWaiting.fetch_add(1u, std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+
+          m_condOnSpace.wait(waitLock, [this] {
+            return !m_queueOrdered.full();
+          });
+
+          m_producersWaiting.fetch_sub(1u, std::memory_order_relaxed);
+        }
+
+        lock.lock();
+      }
+
+      if (timeline)
+        m_seqDispatch.store(seq, std::memory_order_release);
+    }
+
+    // Only take the lock to wake up the worker if it is actually
+    // sleeping, the fence pairs with the one in waitForWork.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_consumerWaiting.load(std::memory_order_relaxed)) {
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
+      m_condOnAdd.notify_one();
+    }
+
+    return seq;
+  }
+
+
+  void DxvkCsThread::waitForWork() {
+    bool hasWork = sync::spinFor(SpinCount, [this] {
+      return !m_queueOrdered.empty()
+          || m_hasHighPrio.load(std::memory_order_acquire)
+          || m_stopped.load(std::memory_order_acquire);
+    });
+
+    if (hasWork)
+      return;
+
+    std::unique_lock<dxvk::mutex> lock(m_mutex);
+    m_consumerWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    m_condOnAdd.wait(lock, [this] {
+      return (!m_queueOrdered.empty())
+          || (!m_queueHighPrio.queue.empty())
+          || (m_stopped.load());
+    });
+
+    m_consumerWaiting.store(false, std::memory_order_relaxed);
+  }
   
   
   void DxvkCsThread::threadFunc() {
     env::setThreadName("dxvk-cs");
 
-    // Local chunk queues, we use two queues and swap between
-    // them in order to potentially reduce lock contention.
-    std::vector<DxvkCsQueuedChunk> ordered;
+    // Local high-priority queue, swapped with the shared
+    // one in order to potentially reduce lock contention.
     std::vector<DxvkCsQueuedChunk> highPrio;
 
-    try {
-      while (!m_stopped.load()) {
-        { std::unique_lock<dxvk::mutex> lock(m_mutex);
+    // Executed chunks that still need to be reset
+    std::vector<DxvkCsChunkRef> retired;
 
-          m_condOnAdd.wait(lock, [this] {
-            return (!m_queueOrdered.queue.empty())
-                || (!m_queueHighPrio.queue.empty())
-                || (m_stopped.load());
-          });
+    auto executeChunk = [&] (DxvkCsQueuedChunk& entry, std::atomic<uint64_t>& counter) {
+      m_context->addStatCtr(DxvkStatCounter::CsChunkCount, 1);
 
-          std::swap(ordered, m_queueOrdered.queue);
-          std::swap(highPrio, m_queueHighPrio.queue);
+      entry.chunk->executeAll(m_context.ptr());
 
-          m_hasHighPrio.store(false, std::memory_order_release);
-        }
+      if (entry.seq) {
+        // Use a separate mutex for the chunk counter, this will only
+        // ever be contested if synchronization is actually necessary.
+        std::lock_guard lock(m_counterMutex);
+        counter.store(entry.seq, std::memory_order_release);
 
-        size_t orderedIndex = 0u;
-        size_t highPrioIndex = 0u;
+        m_condOnSync.notify_one();
+      }
 
-        while (highPrioIndex < highPrio.size() || orderedIndex < ordered.size()) {
-          // Re-fill local high-priority queue if the app has queued anything up
-          // in the meantime, we want to reduce possible synchronization delays.
-          if (highPrioIndex >= highPrio.size() && m_hasHighPrio.load(std::memory_order_acquire)) {
-            highPrio.clear();
-            highPrioIndex = 0u;
+      // Destroying the recorded commands may release the last reference
+      // to resources and is not needed for execution, so hand the chunk
+      // off to the retire worker rather than destroying it in place.
+      retired.push_back(std::move(entry.chunk));
 
-            std::unique_lock<dxvk::mutex> lock(m_mutex);
-            std::swap(highPrio, m_queueHighPrio.queue);
+      if (retired.size() >= MaxRetireBatchSize)
+        retireChunks(retired);
+    };
 
-            m_hasHighPrio.store(false, std::memory_order_release);
-          }
+    try {
+      DxvkCsQueuedChunk ordered;
 
-          // Drain high-priority queue first
-          bool isHighPrio = highPrioIndex < highPrio.size();
-          auto& entry = isHighPrio ? highPrio[highPrioIndex++] : ordered[orderedIndex++];
+      while (!m_stopped.load()) {
+        waitForWork();
 
-          m_context->addStatCtr(DxvkStatCounter::CsChunkCount, 1);
+        // Drain high-priority queue first
+        if (m_hasHighPrio.load(std::memory_order_acquire)) {
+          { std::unique_lock<dxvk::mutex> lock(m_mutex);
+            std::swap(highPrio, m_queueHighPrio.queue);
 
-          entry.chunk->executeAll(m_context.ptr());
+            m_hasHighPrio.store(false, std::memory_order_release);
+          }
 
-          if (entry.seq) {
-            // Use a separate mutex for the chunk counter, this will only
-            // ever be contested if synchronization is actually necessary.
-            std::lock_guard lock(m_counterMutex);
+          for (auto& entry : highPrio)
+            executeChunk(entry, m_seqHighPrio);
 
-            auto& counter = isHighPrio ? m_seqHighPrio : m_seqOrdered;
-            counter.store(entry.seq, std::memory_order_release);
+          highPrio.clear();
+        }
 
-            m_condOnSync.notify_one();
+        // Process the ordered queue until it runs dry, but go back to the
+        // high-priority queue as soon as the app queues anything up there
+        // in order to reduce potential synchronization delays.
+        while (!m_hasHighPrio.load(std::memory_order_acquire) && m_queueOrdered.pop(ordered)) {
+          // The fence pairs with the one in pushOrdered
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+
+          // Multiple producers may be blocked if the lock got dropped
+          if (unlikely(m_producersWaiting.load(std::memory_order_relaxed))) {
+            std::lock_guard<dxvk::mutex> lock(m_mutex);
+            m_condOnSpace.notify_all();
           }
 
-          // Immediately free the chunk to release
-          // references to any resources held by it
-          entry.chunk = DxvkCsChunkRef();
+          executeChunk(ordered, m_seqOrdered);
         }
 
-        ordered.clear();
-        highPrio.clear();
+        if (!retired.empty())
+          retireChunks(retired);
       }
     } catch (const DxvkError& e) {
       Logger::err("Exception on CS thread!");
@@ -263,4 +373,45 @@ namespace dxvk {
     }
   }
   
-}
\ No newline at end of file
+
+  void DxvkCsThread::retireChunks(std::vector<DxvkCsChunkRef>& chunks) {
+    { std::unique_lock<dxvk::mutex> lock(m_retireMutex);
+
+      if (m_retireQueue.empty()) {
+        std::swap(m_retireQueue, chunks);
+      } else {
+        for (auto& chunk : chunks)
+          m_retireQueue.push_back(std::move(chunk));
+      }
+    }
+
+    m_retireCond.notify_one();
+    chunks.clear();
+  }
+
+
+  void DxvkCsThread::retireFunc() {
+    env::setThreadName("dxvk-cs-retire");
+
+    std::vector<DxvkCsChunkRef> chunks;
+
+    while (true) {
+      { std::unique_lock<dxvk::mutex> lock(m_retireMutex);
+
+        m_retireCond.wait(lock, [this] {
+          return !m_retireQueue.empty() || m_retireStopped;
+        });
+
+        if (m_retireQueue.empty())
+          break;
+
+        std::swap(chunks, m_retireQueue);
+      }
+
+      // Dropping the last reference returns
+      // the chunk to the pool and resets it
+      chunks.clear();
+    }
+  }
+
+}
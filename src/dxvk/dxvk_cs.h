@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -7,6 +8,8 @@
 
 #include "../util/thread.h"
 
+#include "../util/sync/sync_spinlock.h"
+
 #include "dxvk_device.h"
 #include "dxvk_context.h"
 
@@ -224,8 +227,8 @@ namespace dxvk {
     /**
      * \brief Executes all commands
      * 
-     * This will also reset the chunk
-     * so that it can be reused.
+     * Recorded commands are only destroyed when the
+     * chunk gets reset, even for single-use chunks.
      * \param [in] ctx The context
      */
     void executeAll(DxvkContext* ctx);
@@ -260,9 +263,17 @@ namespace dxvk {
    * Implements a pool of CS chunks which can be
    * recycled. The goal is to reduce the number
    * of dynamic memory allocations.
+   *
+   * Free chunks are cached in a small number of
+   * shards selected by the calling thread, which
+   * exchange chunks with the global list in batches
+   * in order to reduce lock contention when multiple
+   * threads allocate and free chunks concurrently.
    */
   class DxvkCsChunkPool {
-    
+    constexpr static uint32_t ShardCountLog2  = 3u;
+    constexpr static uint32_t ShardCount      = 1u << ShardCountLog2;
+    constexpr static size_t   BatchSize       = 8u;
   public:
     
     DxvkCsChunkPool();
@@ -290,9 +301,18 @@ namespace dxvk {
     void freeChunk(DxvkCsChunk* chunk);
     
   private:
-    
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+      sync::Spinlock            mutex;
+      std::vector<DxvkCsChunk*> chunks;
+    };
+
+    std::array<Shard, ShardCount> m_shards;
+
     dxvk::mutex               m_mutex;
     std::vector<DxvkCsChunk*> m_chunks;
+
+    Shard& getShard();
     
   };
   
@@ -391,7 +411,7 @@ namespace dxvk {
    */
   struct DxvkCsQueuedChunk {
     DxvkCsChunkRef  chunk;
-    uint64_t        seq;
+    uint64_t        seq = 0u;
   };
 
 
@@ -407,6 +427,87 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Chunk ring buffer
+   *
+   * Bounded queue that allows one thread to push and one thread
+   * to pop chunks without taking a lock. Producers must be
+   * serialized externally if more than one thread can push.
+   */
+  class DxvkCsChunkRing {
+    constexpr static uint64_t Capacity = 4096u;
+  public:
+
+    /**
+     * \brief Checks whether the ring is empty
+     * \returns \c true if no chunks are queued
+     */
+    bool empty() const {
+      return m_readIndex.load(std::memory_order_acquire)
+          == m_writeIndex.load(std::memory_order_acquire);
+    }
+
+    /**
+     * \brief Checks whether the ring is full
+     * \returns \c true if no more chunks can be queued
+     */
+    bool full() const {
+      return m_writeIndex.load(std::memory_order_acquire)
+           - m_readIndex.load(std::memory_order_acquire) >= Capacity;
+    }
+
+    /**
+     * \brief Adds a chunk to the ring
+     *
+     * Must only be called from the producer thread.
+     * \param [in] entry Chunk entry to add. Left
+     *    untouched if the ring is full.
+     * \returns \c false if the ring is full
+     */
+    bool push(DxvkCsQueuedChunk& entry) {
+      uint64_t w = m_writeIndex.load(std::memory_order_relaxed);
+      uint64_t r = m_readIndex.load(std::memory_order_acquire);
+
+      if (unlikely(w - r >= Capacity))
+        return false;
+
+      m_entries[w % Capacity] = std::move(entry);
+      m_writeIndex.store(w + 1u, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * \brief Removes a chunk from the ring
+     *
+     * Must only be called from the consumer thread.
+     * \param [out] entry Chunk entry
+     * \returns \c false if the ring is empty
+     */
+    bool pop(DxvkCsQueuedChunk& entry) {
+      uint64_t r = m_readIndex.load(std::memory_order_relaxed);
+      uint64_t w = m_writeIndex.load(std::memory_order_acquire);
+
+      if (r == w)
+        return false;
+
+      entry = std::move(m_entries[r % Capacity]);
+      m_readIndex.store(r + 1u, std::memory_order_release);
+      return true;
+    }
+
+  private:
+
+    alignas(CACHE_LINE_SIZE)
+    std::atomic<uint64_t> m_writeIndex = { 0u };
+
+    alignas(CACHE_LINE_SIZE)
+    std::atomic<uint64_t> m_readIndex = { 0u };
+
+    std::array<DxvkCsQueuedChunk, Capacity> m_entries;
+
+  };
+
+
   /**
    * \brief Command stream thread
    * 
@@ -414,7 +515,12 @@ namespace dxvk {
    * commands on a DXVK context. 
    */
   class DxvkCsThread {
-    
+    /// Maximum number of executed chunks to accumulate
+    /// before passing them to the retire worker
+    constexpr static size_t MaxRetireBatchSize = 16u;
+    /// Number of probes before a thread waiting
+    /// on the ordered ring goes to sleep
+    constexpr static uint32_t SpinCount = 256u;
   public:
 
     constexpr static uint64_t SynchronizeAll = ~0ull;
@@ -489,24 +595,45 @@ namespace dxvk {
     alignas(CACHE_LINE_SIZE)
     dxvk::mutex                 m_mutex;
     dxvk::condition_variable    m_condOnAdd;
+    dxvk::condition_variable    m_condOnSpace;
     dxvk::condition_variable    m_condOnSync;
 
-    DxvkCsChunkQueue            m_queueOrdered;
     DxvkCsChunkQueue            m_queueHighPrio;
 
-    dxvk::thread                m_thread;
+    alignas(CACHE_LINE_SIZE)
+    sync::Spinlock              m_producerLock;
+    std::atomic<uint64_t>       m_seqDispatch       = { 0u };
 
-    auto& getQueue(DxvkCsQueue which) {
-      return which == DxvkCsQueue::Ordered
-        ? m_queueOrdered : m_queueHighPrio;
-    }
+    std::atomic<bool>           m_consumerWaiting   = { false };
+    std::atomic<uint32_t>       m_producersWaiting  = { 0u };
+
+    DxvkCsChunkRing             m_queueOrdered;
+
+    alignas(CACHE_LINE_SIZE)
+    dxvk::mutex                 m_retireMutex;
+    dxvk::condition_variable    m_retireCond;
+    std::vector<DxvkCsChunkRef> m_retireQueue;
+    bool                        m_retireStopped = false;
+
+    dxvk::thread                m_thread;
+    dxvk::thread                m_retireThread;
 
     auto& getCounter(DxvkCsQueue which) {
       return which == DxvkCsQueue::Ordered
         ? m_seqOrdered : m_seqHighPrio;
     }
 
+    uint64_t pushOrdered(
+            DxvkCsChunkRef&&  chunk,
+            bool              timeline);
+
+    void waitForWork();
+
     void threadFunc();
+
+    void retireChunks(std::vector<DxvkCsChunkRef>& chunks);
+
+    void retireFunc();
     
   };
   
@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "dxvk_descriptor.h"
 #include "dxvk_device.h"
 
@@ -33,6 +35,81 @@ namespace dxvk {
 
 
 
+  DxvkDescriptorSetCache::DxvkDescriptorSetCache() {
+
+  }
+
+
+  DxvkDescriptorSetCache::~DxvkDescriptorSetCache() {
+
+  }
+
+
+  VkDescriptorSet DxvkDescriptorSetCache::find(
+          VkDescriptorSetLayout     layout,
+          uint32_t                  count,
+    const DxvkDescriptorInfo*       descriptors) const {
+    auto range = m_entries.equal_range(hash(layout, count, descriptors));
+
+    for (auto i = range.first; i != range.second; i++) {
+      const auto& entry = i->second;
+
+      if (entry.layout == layout && entry.count == count
+       && !std::memcmp(&m_descriptors[entry.offset], descriptors, count * sizeof(*descriptors)))
+        return entry.set;
+    }
+
+    return VK_NULL_HANDLE;
+  }
+
+
+  void DxvkDescriptorSetCache::insert(
+          VkDescriptorSetLayout     layout,
+          uint32_t                  count,
+    const DxvkDescriptorInfo*       descriptors,
+          VkDescriptorSet           set) {
+    // Bound memory usage and lookup cost in case
+    // the application rarely reuses any bindings
+    if (unlikely(m_entries.size() >= MaxEntryCount))
+      clear();
+
+    Entry entry;
+    entry.layout = layout;
+    entry.set    = set;
+    entry.offset = m_descriptors.size();
+    entry.count  = count;
+
+    m_descriptors.insert(m_descriptors.end(), descriptors, descriptors + count);
+    m_entries.emplace(hash(layout, count, descriptors), entry);
+  }
+
+
+  void DxvkDescriptorSetCache::clear() {
+    m_entries.clear();
+    m_descriptors.clear();
+  }
+
+
+  size_t DxvkDescriptorSetCache::hash(
+          VkDescriptorSetLayout     layout,
+          uint32_t                  count,
+    const DxvkDescriptorInfo*       descriptors) {
+    DxvkHashState state;
+    state.add(std::hash<VkDescriptorSetLayout>()(layout));
+    state.add(count);
+
+    // Descriptors are zero-initialized before they are written,
+    // so hashing the raw data is consistent with memcmp.
+    auto data = reinterpret_cast<const uint32_t*>(descriptors);
+
+    for (size_t i = 0; i < count * sizeof(*descriptors) / sizeof(*data); i++)
+      state.add(data[i]);
+
+    return state;
+  }
+
+
+
   DxvkDescriptorPool::DxvkDescriptorPool(
           DxvkDevice*               device,
           DxvkDescriptorManager*    manager)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include "dxvk_include.h"
@@ -49,6 +50,75 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Descriptor set content cache
+   *
+   * Maps descriptor set layouts and descriptor contents to
+   * descriptor sets that have already been written with the
+   * same data, so that identical sets can be reused rather
+   * than allocated and updated again. The cache must be
+   * cleared before any resource referenced by a cached
+   * set can be destroyed, i.e. once per command list.
+   */
+  class DxvkDescriptorSetCache {
+    constexpr static size_t MaxEntryCount = 4096;
+  public:
+
+    DxvkDescriptorSetCache();
+    ~DxvkDescriptorSetCache();
+
+    /**
+     * \brief Looks up a descriptor set
+     *
+     * \param [in] layout Descriptor set layout
+     * \param [in] count Number of descriptors
+     * \param [in] descriptors Descriptor data
+     * \returns Matching descriptor set, or \c VK_NULL_HANDLE
+     */
+    VkDescriptorSet find(
+            VkDescriptorSetLayout     layout,
+            uint32_t                  count,
+      const DxvkDescriptorInfo*       descriptors) const;
+
+    /**
+     * \brief Adds a descriptor set
+     *
+     * \param [in] layout Descriptor set layout
+     * \param [in] count Number of descriptors
+     * \param [in] descriptors Descriptor data
+     * \param [in] set Descriptor set written with the given data
+     */
+    void insert(
+            VkDescriptorSetLayout     layout,
+            uint32_t                  count,
+      const DxvkDescriptorInfo*       descriptors,
+            VkDescriptorSet           set);
+
+    /**
+     * \brief Removes all cached sets
+     */
+    void clear();
+
+  private:
+
+    struct Entry {
+      VkDescriptorSetLayout layout;
+      VkDescriptorSet       set;
+      size_t                offset;
+      uint32_t              count;
+    };
+
+    std::unordered_multimap<size_t, Entry>  m_entries;
+    std::vector<DxvkDescriptorInfo>         m_descriptors;
+
+    static size_t hash(
+            VkDescriptorSetLayout     layout,
+            uint32_t                  count,
+      const DxvkDescriptorInfo*       descriptors);
+
+  };
+
+
   /**
    * \brief Persistent descriptor set map
    *
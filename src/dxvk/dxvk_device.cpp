@@ -244,6 +244,11 @@ namespace dxvk {
   }
 
 
+  DxvkPipelineCompileTimes DxvkDevice::getPipelineCompileTimes() {
+    return m_objects.pipelineManager().getCompileTimes();
+  }
+
+
   DxvkStatCounters DxvkDevice::getStatCounters() {
     DxvkPipelineCount pipe = m_objects.pipelineManager().getPipelineCount();
     DxvkPipelineWorkerStats workers = m_objects.pipelineManager().getWorkerStats();
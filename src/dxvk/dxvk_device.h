@@ -420,6 +420,15 @@ namespace dxvk {
      */
     DxvkStatCounters getStatCounters();
 
+    /**
+     * \brief Retrieves pipeline compile time statistics
+     *
+     * Used by the HUD to display which pipelines
+     * took the longest to compile.
+     * \returns Compile time histogram and slowest pipelines
+     */
+    DxvkPipelineCompileTimes getPipelineCompileTimes();
+
     /**
      * \brief Queries memory statistics
      *
@@ -555,6 +564,26 @@ namespace dxvk {
       m_statCounters.addCtr(counter, value);
     }
 
+    /**
+     * \brief Enables command timing counters
+     *
+     * Makes contexts measure CPU time spent in some of
+     * the more expensive state update functions. This
+     * has measurable overhead, so it is only enabled
+     * when something actually consumes the counters.
+     */
+    void enableCommandTimings() {
+      m_cmdTimings.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Checks whether command timings are enabled
+     * \returns \c true if contexts should time commands
+     */
+    bool hasCommandTimings() const {
+      return m_cmdTimings.load(std::memory_order_relaxed);
+    }
+
     /**
      * \brief Waits for a given submission
      * 
@@ -610,6 +639,7 @@ namespace dxvk {
 
     sync::Spinlock              m_statLock;
     DxvkStatCounters            m_statCounters;
+    std::atomic<bool>           m_cmdTimings = { false };
     
     DxvkRecycler<DxvkCommandList, 16> m_recycledCommandLists;
     
@@ -999,7 +999,14 @@ namespace dxvk {
 
   std::pair<VkPipeline, DxvkGraphicsPipelineType> DxvkGraphicsPipeline::getPipelineHandle(
     const DxvkGraphicsPipelineStateInfo& state) {
-    DxvkGraphicsPipelineInstance* instance = this->findInstance(state);
+    // Check the most recently used instance first, since apps tend to
+    // use any given shader combination with the same state repeatedly.
+    DxvkGraphicsPipelineInstance* instance = m_lastInstance.load(std::memory_order_acquire);
+
+    if (likely(instance && instance->state == state))
+      return getInstanceHandle(instance);
+
+    instance = this->findInstance(state);
 
     if (unlikely(!instance)) {
       // Exit early if the state vector is invalid
@@ -1031,6 +1038,13 @@ namespace dxvk {
       }
     }
 
+    m_lastInstance.store(instance, std::memory_order_release);
+    return getInstanceHandle(instance);
+  }
+
+
+  std::pair<VkPipeline, DxvkGraphicsPipelineType> DxvkGraphicsPipeline::getInstanceHandle(
+    const DxvkGraphicsPipelineInstance*  instance) const {
     // Find a pipeline handle to use. If no optimized pipeline has
     // been compiled yet, use the slower base pipeline instead.
     VkPipeline fastHandle = instance->fastHandle.load();
@@ -1264,6 +1278,8 @@ namespace dxvk {
     DxvkShaderPipelineLibraryHandle vs = m_vsLibrary->acquirePipelineHandle();
     DxvkShaderPipelineLibraryHandle fs = m_fsLibrary->acquirePipelineHandle();
 
+    auto t0 = dxvk::high_resolution_clock::now();
+
     std::array<VkPipeline, 4> libraries = {{
       key.viLibrary->getHandle(), vs.handle, fs.handle,
       key.foLibrary->getHandle(),
@@ -1279,11 +1295,17 @@ namespace dxvk {
     info.basePipelineIndex  = -1;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), VK_NULL_HANDLE, 1, &info, nullptr, &pipeline);
+    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), m_manager->m_stateCache.getPipelineCache(), 1, &info, nullptr, &pipeline);
 
     if (vr && vr != VK_PIPELINE_COMPILE_REQUIRED_EXT)
       Logger::err(str::format("DxvkGraphicsPipeline: Failed to create base pipeline: ", vr));
 
+    if (pipeline) {
+      auto t1 = dxvk::high_resolution_clock::now();
+      m_stats->recordCompileTime("linked", m_debugName,
+        std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0));
+    }
+
     return pipeline;
   }
 
@@ -1314,6 +1336,7 @@ namespace dxvk {
   VkPipeline DxvkGraphicsPipeline::createOptimizedPipeline(
     const DxvkGraphicsPipelineFastInstanceKey& key) const {
     auto vk = m_device->vkd();
+    auto t0 = dxvk::high_resolution_clock::now();
 
     DxvkShaderStageInfo stageInfo(m_device);
     stageInfo.addStage(VK_SHADER_STAGE_VERTEX_BIT, getShaderCode(m_shaders.vs, key.shState.vsInfo), &key.scState.scInfo);
@@ -1352,13 +1375,17 @@ namespace dxvk {
       info.flags |= VK_PIPELINE_CREATE_DEPTH_STENCIL_ATTACHMENT_FEEDBACK_LOOP_BIT_EXT;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), VK_NULL_HANDLE, 1, &info, nullptr, &pipeline);
+    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), m_manager->m_stateCache.getPipelineCache(), 1, &info, nullptr, &pipeline);
 
     if (vr != VK_SUCCESS) {
       Logger::err(str::format("DxvkGraphicsPipeline: Failed to compile pipeline: ", vr));
       return VK_NULL_HANDLE;
     }
 
+    auto t1 = dxvk::high_resolution_clock::now();
+    m_stats->recordCompileTime("optimized", m_debugName,
+      std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0));
+
     return pipeline;
   }
   
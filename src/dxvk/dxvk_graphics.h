@@ -600,6 +600,8 @@ namespace dxvk {
     sync::List<DxvkGraphicsPipelineInstance>      m_pipelines;
     uint32_t                                      m_useCount = 0;
 
+    std::atomic<DxvkGraphicsPipelineInstance*>    m_lastInstance = { nullptr };
+
     std::unordered_map<
       DxvkGraphicsPipelineBaseInstanceKey,
       VkPipeline, DxvkHash, DxvkEq>               m_basePipelines;
@@ -617,6 +619,9 @@ namespace dxvk {
     DxvkGraphicsPipelineInstance* findInstance(
       const DxvkGraphicsPipelineStateInfo& state);
 
+    std::pair<VkPipeline, DxvkGraphicsPipelineType> getInstanceHandle(
+      const DxvkGraphicsPipelineInstance*  instance) const;
+
     bool canCreateBasePipeline(
       const DxvkGraphicsPipelineStateInfo& state) const;
 
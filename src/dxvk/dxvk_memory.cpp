@@ -1,7 +1,13 @@
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #include "../util/util_bit.h"
 
 #include "dxvk_device.h"
@@ -109,13 +115,17 @@ namespace dxvk {
 
   VkImageView DxvkResourceImageViewMap::createImageView(
     const DxvkImageViewKey&           key) {
-    std::lock_guard lock(m_mutex);
+    std::unique_lock lock(m_mutex);
 
     auto entry = m_views.find(key);
 
     if (entry != m_views.end())
       return entry->second;
 
+    // Creating the view may be expensive, so don't
+    // block other threads looking up existing views
+    lock.unlock();
+
     VkImageViewUsageCreateInfo usage = { VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO };
     usage.usage = key.usage;
 
@@ -138,8 +148,16 @@ namespace dxvk {
     if (vr != VK_SUCCESS)
       throw DxvkError(str::format("Failed to create Vulkan image view: ", vr));
 
-    m_views.insert({ key, view });
-    return view;
+    lock.lock();
+
+    // Another thread may have created the same view in the
+    // meantime, in which case we need to discard ours
+    auto result = m_views.insert({ key, view });
+
+    if (!result.second)
+      m_vkd->vkDestroyImageView(m_vkd->device(), view, nullptr);
+
+    return result.first->second;
   }
 
 
@@ -294,9 +312,9 @@ namespace dxvk {
 
     // Initialize unallocated list of lists
     for (uint32_t i = 0u; i < m_lists.size() - 1u; i++)
-      m_lists[i].next = i + 1;
+      m_lists[i].next.store(i + 1, std::memory_order_relaxed);
 
-    m_nextList = 0;
+    m_nextList.store(0u, std::memory_order_release);
   }
 
 
@@ -314,30 +332,27 @@ namespace dxvk {
     uint32_t poolIndex = DxvkLocalAllocationCache::computePoolIndex(allocationSize);
 
     // If there's a list ready for us, take the whole thing
-    std::unique_lock poolLock(m_poolMutex);
-    m_numRequests += 1u;
+    m_numRequests.fetch_add(1u, std::memory_order_relaxed);
 
     auto& pool = m_pools[poolIndex];
-    int32_t listIndex = pool.listIndex;
+    int32_t listIndex = popList(pool.listStack);
 
     if (listIndex < 0) {
-      m_numMisses += 1u;
+      m_numMisses.fetch_add(1u, std::memory_order_relaxed);
       return nullptr;
     }
 
-    if (!(--pool.listCount))
-      pool.drainTime = high_resolution_clock::now();
-
-    // Extract allocations and mark list as free
-    DxvkResourceAllocation* allocation = m_lists[listIndex].head;
-    pool.listIndex = m_lists[listIndex].next;
-
-    m_lists[listIndex].head = nullptr;
-    m_lists[listIndex].next = m_nextList;
+    if (pool.listCount.fetch_sub(1u, std::memory_order_relaxed) == 1u) {
+      pool.drainTime.store(high_resolution_clock::now().time_since_epoch().count(),
+        std::memory_order_relaxed);
+    }
 
-    m_nextList = listIndex;
+    // Extract allocations and mark list as free. We own
+    // the list at this point, so no synchronization needed.
+    DxvkResourceAllocation* allocation = std::exchange(m_lists[listIndex].head, nullptr);
+    pushList(m_nextList, listIndex);
 
-    m_cacheSize -= PoolCapacityInBytes;
+    m_cacheSize.fetch_sub(PoolCapacityInBytes, std::memory_order_relaxed);
     return allocation;
   }
 
@@ -362,71 +377,74 @@ namespace dxvk {
     }
 
     // Add free list to the pool if possible.
-    { std::unique_lock poolLock(m_poolMutex);
-      auto& pool = m_pools[poolIndex];
-
-      if (unlikely(m_nextList < 0)) {
-        // Cache is currently full, see if we can steal a list from
-        // the largest pool. This automatically balances pool sizes
-        // under cache pressure.
-        uint32_t largestPoolIndex = 0;
-
-        for (uint32_t i = 1; i < PoolCount; i++) {
-          if (m_pools[i].listCount > m_pools[largestPoolIndex].listCount)
-            largestPoolIndex = i;
+    auto& pool = m_pools[poolIndex];
+    int32_t listIndex = popList(m_nextList);
+
+    if (unlikely(listIndex < 0)) {
+      // Cache is currently full, see if we can steal a list from
+      // the largest pool. This automatically balances pool sizes
+      // under cache pressure. List counts may be slightly out of
+      // date here, which is fine since this is only a heuristic.
+      uint32_t largestPoolIndex = 0;
+      uint32_t largestPoolCount = m_pools[0].listCount.load(std::memory_order_relaxed);
+
+      for (uint32_t i = 1; i < PoolCount; i++) {
+        uint32_t count = m_pools[i].listCount.load(std::memory_order_relaxed);
+
+        if (count > largestPoolCount) {
+          largestPoolIndex = i;
+          largestPoolCount = count;
         }
+      }
 
-        // If the current pool is already (one of) the largest, give up
-        // and free the entire list to avoid pools playing ping-pong.
-        if (m_pools[largestPoolIndex].listCount == pool.listCount)
-          return allocation;
+      // If the current pool is already (one of) the largest, give up
+      // and free the entire list to avoid pools playing ping-pong.
+      if (largestPoolCount == pool.listCount.load(std::memory_order_relaxed))
+        return allocation;
 
-        // Move first list of largest pool to current pool and free any
-        // allocations associated with it.
-        auto& largestPool = m_pools[largestPoolIndex];
-        int32_t listIndex = largestPool.listIndex;
+      // Move first list of largest pool to current pool and free any
+      // allocations associated with it. If another thread drained the
+      // pool in the meantime, just free the list instead.
+      auto& largestPool = m_pools[largestPoolIndex];
+      listIndex = popList(largestPool.listStack);
 
-        DxvkResourceAllocation* result = m_lists[listIndex].head;
-        largestPool.listIndex = m_lists[listIndex].next;
-        largestPool.listCount -= 1u;
+      if (listIndex < 0)
+        return allocation;
 
-        m_lists[listIndex].head = allocation;
-        m_lists[listIndex].next = pool.listIndex;
+      largestPool.listCount.fetch_sub(1u, std::memory_order_relaxed);
 
-        pool.listIndex = listIndex;
-        pool.listCount += 1u;
-        return result;
-      } else {
-        // Otherwise, allocate a fresh list and assign it to the pool
-        int32_t listIndex = m_nextList;
-        m_nextList = m_lists[listIndex].next;
+      // Increment the count before pushing the list so that a concurrent
+      // allocation popping it cannot make the count underflow.
+      DxvkResourceAllocation* result = std::exchange(m_lists[listIndex].head, allocation);
 
-        m_lists[listIndex].head = allocation;
-        m_lists[listIndex].next = pool.listIndex;
+      pool.listCount.fetch_add(1u, std::memory_order_relaxed);
+      pushList(pool.listStack, listIndex);
+      return result;
+    } else {
+      // Otherwise, assign the fresh list to the pool
+      m_lists[listIndex].head = allocation;
 
-        pool.listIndex = listIndex;
-        pool.listCount += 1u;
+      pool.listCount.fetch_add(1u, std::memory_order_relaxed);
+      pushList(pool.listStack, listIndex);
 
-        if ((m_cacheSize += PoolCapacityInBytes) > m_maxCacheSize)
-          m_maxCacheSize = m_cacheSize;
+      VkDeviceSize cacheSize = m_cacheSize.fetch_add(PoolCapacityInBytes,
+        std::memory_order_relaxed) + PoolCapacityInBytes;
+      VkDeviceSize maxCacheSize = m_maxCacheSize.load(std::memory_order_relaxed);
 
-        return nullptr;
-      }
+      while (cacheSize > maxCacheSize && !m_maxCacheSize.compare_exchange_weak(
+        maxCacheSize, cacheSize, std::memory_order_relaxed))
+        continue;
+
+      return nullptr;
     }
   }
 
 
   DxvkSharedAllocationCacheStats DxvkSharedAllocationCache::getStats() {
-    std::unique_lock poolLock(m_poolMutex);
-
     DxvkSharedAllocationCacheStats result = { };
-    result.requestCount = m_numRequests;
-    result.missCount = m_numMisses;
-    result.size = m_maxCacheSize;
-
-    m_numRequests = 0u;
-    m_numMisses = 0u;
-    m_maxCacheSize = 0u;
+    result.requestCount = m_numRequests.exchange(0u, std::memory_order_relaxed);
+    result.missCount = m_numMisses.exchange(0u, std::memory_order_relaxed);
+    result.size = m_maxCacheSize.exchange(0u, std::memory_order_relaxed);
     return result;
   }
 
@@ -436,29 +454,65 @@ namespace dxvk {
     std::unique_lock poolLock(m_poolMutex);
 
     for (auto& pool : m_pools) {
-      int32_t listIndex = pool.listIndex;
+      auto drainTime = high_resolution_clock::time_point(high_resolution_clock::duration(
+        pool.drainTime.load(std::memory_order_relaxed)));
+
+      if (time - drainTime < std::chrono::seconds(1u))
+        continue;
+
+      int32_t listIndex = popList(pool.listStack);
 
       if (listIndex < 0)
         continue;
 
-      if (time - pool.drainTime >= std::chrono::seconds(1u)) {
-        m_allocator->freeCachedAllocationsLocked(m_lists[listIndex].head);
+      m_allocator->freeCachedAllocationsLocked(std::exchange(m_lists[listIndex].head, nullptr));
+      pushList(m_nextList, listIndex);
 
-        pool.listIndex = m_lists[listIndex].next;
-        pool.listCount -= 1u;
-        pool.drainTime = time;
+      pool.listCount.fetch_sub(1u, std::memory_order_relaxed);
+      pool.drainTime.store(time.time_since_epoch().count(), std::memory_order_relaxed);
 
-        m_lists[listIndex].head = nullptr;
-        m_lists[listIndex].next = m_nextList;
+      m_cacheSize.fetch_sub(PoolCapacityInBytes, std::memory_order_relaxed);
+    }
+  }
 
-        m_nextList = listIndex;
 
-        m_cacheSize -= PoolCapacityInBytes;
-      }
+  int32_t DxvkSharedAllocationCache::popList(
+          std::atomic<uint64_t>&      stack) {
+    uint64_t head = stack.load(std::memory_order_acquire);
+
+    while (true) {
+      int32_t listIndex = int32_t(uint32_t(head));
+
+      if (listIndex < 0)
+        return -1;
+
+      // The list may get popped and reused by another thread between
+      // reading the link and the exchange, but the tag will have
+      // changed in that case and the exchange will fail.
+      uint32_t next = uint32_t(m_lists[listIndex].next.load(std::memory_order_relaxed));
+      uint64_t tag = (head >> 32u) + 1u;
+
+      if (stack.compare_exchange_weak(head, uint64_t(next) | (tag << 32u),
+          std::memory_order_acquire, std::memory_order_acquire))
+        return listIndex;
     }
   }
 
 
+  void DxvkSharedAllocationCache::pushList(
+          std::atomic<uint64_t>&      stack,
+          int32_t                     listIndex) {
+    uint64_t head = stack.load(std::memory_order_relaxed);
+    uint64_t tag;
+
+    do {
+      m_lists[listIndex].next.store(int32_t(uint32_t(head)), std::memory_order_relaxed);
+      tag = (head >> 32u) + 1u;
+    } while (!stack.compare_exchange_weak(head, uint64_t(uint32_t(listIndex)) | (tag << 32u),
+      std::memory_order_release, std::memory_order_relaxed));
+  }
+
+
 
 
   DxvkRelocationList::DxvkRelocationList() {
@@ -562,6 +616,8 @@ namespace dxvk {
     determineBufferUsageFlagsPerMemoryType();
 
     updateMemoryHeapBudgets();
+
+    openTraceFile();
   }
   
   
@@ -932,6 +988,17 @@ namespace dxvk {
       dedicatedRequirements.prefersDedicatedAllocation = VK_TRUE;
     }
 
+    // Suballocated resources all share the same memory priority, so large
+    // render targets would be just as likely to get evicted as rarely used
+    // textures. Use a dedicated allocation for these so that the driver
+    // can keep them resident over other resources when under pressure.
+    if ((createInfo.usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT))
+     && (allocationInfo.properties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+     && (requirements.memoryRequirements.size >= MinHighPriorityImageSize)
+     && (m_device->features().extMemoryPriority.memoryPriority
+      || m_device->features().extPageableDeviceLocalMemory.pageableDeviceLocalMemory))
+      dedicatedRequirements.prefersDedicatedAllocation = VK_TRUE;
+
     Rc<DxvkResourceAllocation> allocation;
 
     if (!(createInfo.flags & VK_IMAGE_CREATE_SPARSE_BINDING_BIT)) {
@@ -1349,6 +1416,9 @@ namespace dxvk {
     if (&pool == &type.devicePool)
       chunk.addAllocation(allocation);
 
+    if (unlikely(m_traceFile.is_open()))
+      traceAllocationLocked(DxvkMemoryTraceEvent::Alloc, allocation);
+
     return allocation;
   }
 
@@ -1387,6 +1457,10 @@ namespace dxvk {
 
     allocation->m_buffer = memory.buffer;
     allocation->m_bufferAddress = memory.gpuVa;
+
+    if (unlikely(m_traceFile.is_open()))
+      traceAllocationLocked(DxvkMemoryTraceEvent::Alloc, allocation);
+
     return allocation;
   }
 
@@ -1402,6 +1476,45 @@ namespace dxvk {
   }
 
 
+  void DxvkMemoryAllocator::openTraceFile() {
+    std::string path = env::getEnvVar("DXVK_MEMORY_TRACE");
+
+    if (path.empty())
+      return;
+
+    m_traceFile = std::ofstream(str::topath(path.c_str()).c_str(),
+      std::ios_base::binary | std::ios_base::trunc);
+
+    if (!m_traceFile) {
+      Logger::warn(str::format("Memory: Failed to open trace file ", path));
+      return;
+    }
+
+    Logger::info(str::format("Memory: Writing allocation trace to ", path));
+    m_traceStart = high_resolution_clock::now();
+  }
+
+
+  void DxvkMemoryAllocator::traceAllocationLocked(
+          DxvkMemoryTraceEvent  event,
+    const DxvkResourceAllocation* allocation) {
+    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+      high_resolution_clock::now() - m_traceStart);
+
+    DxvkMemoryTraceRecord record = { };
+    record.timestamp = timestamp.count();
+    record.allocationId = reinterpret_cast<uintptr_t>(allocation);
+    record.address = allocation->m_address;
+    record.size = allocation->m_size;
+    record.event = event;
+    record.heap = allocation->m_type->properties.heapIndex;
+    record.type = allocation->m_type->index;
+    record.mapped = allocation->m_mapPtr ? 1u : 0u;
+
+    m_traceFile.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+
+
   void DxvkMemoryAllocator::freeAllocation(
           DxvkResourceAllocation* allocation) {
     if (allocation->m_flags.test(DxvkAllocationFlag::ClearOnFree)) {
@@ -1423,6 +1536,9 @@ namespace dxvk {
       std::unique_lock lock(m_mutex);
 
       if (likely(allocation->m_type)) {
+        if (unlikely(m_traceFile.is_open()))
+          traceAllocationLocked(DxvkMemoryTraceEvent::Free, allocation);
+
         allocation->m_type->stats.memoryUsed -= allocation->m_size;
 
         if (unlikely(allocation->m_flags.test(DxvkAllocationFlag::OwnsMemory))) {
@@ -1482,6 +1598,9 @@ namespace dxvk {
       // still own the memory, so make sure to release it here.
       allocation->m_type->stats.memoryUsed -= allocation->m_size;
 
+      if (unlikely(m_traceFile.is_open()))
+        traceAllocationLocked(DxvkMemoryTraceEvent::Free, allocation);
+
       if (unlikely(pool.free(allocation->m_address, allocation->m_size))) {
         if (freeEmptyChunksInPool(*allocation->m_type, pool, 0, high_resolution_clock::now()))
           updateMemoryHeapStats(allocation->m_type->properties.heapIndex);
@@ -1610,6 +1729,9 @@ namespace dxvk {
           "\n  size: ", memory.size, " bytes"));
       }
 
+      if (m_device->config().hugePageMappings)
+        adviseHugePages(memory);
+
       if (m_device->config().zeroMappedMemory)
         bit::bclear(memory.mapPtr, memory.size);
 
@@ -1632,6 +1754,27 @@ namespace dxvk {
   }
 
 
+  void DxvkMemoryAllocator::adviseHugePages(
+    const DxvkDeviceMemory&     memory) {
+#if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+    constexpr static uintptr_t HugePageSize = 2u << 20;
+
+    // Only use the part of the mapping that is aligned to the huge page
+    // size. This is purely a hint, and the kernel will ignore it if the
+    // driver maps device memory or uses a special mapping.
+    uintptr_t base = reinterpret_cast<uintptr_t>(memory.mapPtr);
+    uintptr_t start = align(base, HugePageSize);
+    uintptr_t end = (base + memory.size) & ~(HugePageSize - 1u);
+
+    if (start >= end)
+      return;
+
+    if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE))
+      Logger::debug(str::format("Memory: madvise failed: ", std::strerror(errno)));
+#endif
+  }
+
+
   bool DxvkMemoryAllocator::refillAllocationCache(
           DxvkLocalAllocationCache*   cache,
     const VkMemoryRequirements&       requirements,
@@ -2362,6 +2505,11 @@ namespace dxvk {
     // Re-query current memory budgets
     updateMemoryHeapBudgets();
 
+    // Flush trace periodically so that it remains
+    // useful if the application crashes
+    if (unlikely(m_traceFile.is_open()))
+      m_traceFile.flush();
+
     // Periodically free unused memory chunks and update
     // memory allocation statistics for the adapter.
     for (uint32_t i = 0; i < m_memHeapCount; i++)
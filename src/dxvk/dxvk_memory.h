@@ -1,5 +1,6 @@
 #pragma once
 
+#include <fstream>
 #include <map>
 #include <memory>
 
@@ -901,15 +902,20 @@ namespace dxvk {
       DxvkResourceAllocation* head = nullptr;
     };
 
+    // Lists are linked into lock-free stacks. The lower 32 bits of
+    // each stack head store the list index, the upper 32 bits store
+    // a tag that is incremented on every operation to avoid ABA.
+    constexpr static uint64_t EmptyStack = 0xffffffffu;
+
     struct List {
       DxvkResourceAllocation* head = nullptr;
-      int32_t                 next = -1;
+      std::atomic<int32_t>    next = { -1 };
     };
 
     struct Pool {
-      int32_t   listIndex = -1;
-      uint32_t  listCount = 0u;
-      high_resolution_clock::time_point drainTime = { };
+      std::atomic<uint64_t> listStack = { EmptyStack };
+      std::atomic<uint32_t> listCount = { 0u };
+      std::atomic<high_resolution_clock::rep> drainTime = { 0 };
     };
 
     alignas(CACHE_LINE_SIZE)
@@ -922,13 +928,20 @@ namespace dxvk {
     dxvk::mutex                 m_poolMutex;
     std::array<Pool, PoolCount> m_pools = { };
     std::array<List, PoolSize>  m_lists = { };
-    int32_t                     m_nextList = -1;
+    std::atomic<uint64_t>       m_nextList = { EmptyStack };
+
+    std::atomic<uint32_t>       m_numRequests = { 0u };
+    std::atomic<uint32_t>       m_numMisses = { 0u };
+
+    std::atomic<VkDeviceSize>   m_cacheSize = { 0u };
+    std::atomic<VkDeviceSize>   m_maxCacheSize = { 0u };
 
-    uint32_t                    m_numRequests = 0u;
-    uint32_t                    m_numMisses = 0u;
+    int32_t popList(
+            std::atomic<uint64_t>&      stack);
 
-    VkDeviceSize                m_cacheSize = 0u;
-    VkDeviceSize                m_maxCacheSize = 0u;
+    void pushList(
+            std::atomic<uint64_t>&      stack,
+            int32_t                     listIndex);
 
   };
 
@@ -979,6 +992,49 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Memory trace event
+   */
+  enum class DxvkMemoryTraceEvent : uint8_t {
+    Alloc = 0,
+    Free  = 1,
+  };
+
+
+  /**
+   * \brief Memory trace record
+   *
+   * Written to the trace file for each memory allocation and
+   * each time the memory is returned to the allocator. Cached
+   * allocations are considered live until they are actually
+   * released, so the trace reflects memory allocator state.
+   */
+  struct DxvkMemoryTraceRecord {
+    /// Time since trace start, in microseconds
+    uint64_t timestamp;
+    /// Unique ID of a live allocation. May be
+    /// reused after the allocation is freed.
+    uint64_t allocationId;
+    /// Address within the memory pool. Has the
+    /// top bit set for dedicated allocations.
+    uint64_t address;
+    /// Allocation size, in bytes
+    uint64_t size;
+    /// Event type
+    DxvkMemoryTraceEvent event;
+    /// Memory heap index
+    uint8_t heap;
+    /// Memory type index
+    uint8_t type;
+    /// Whether the allocation is host-visible
+    uint8_t mapped;
+    /// Reserved for future use
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(DxvkMemoryTraceRecord) == 40);
+
+
   /**
    * \brief Relocation entry
    */
@@ -1090,6 +1146,11 @@ namespace dxvk {
 
     // Minimum number of allocations we want to be able to fit into a heap
     constexpr static uint32_t MinAllocationsPerHeap = 7u;
+
+    // Minimum size for render targets to get a dedicated allocation,
+    // and with that a high residency priority, when the driver
+    // supports memory priorities.
+    constexpr static VkDeviceSize MinHighPriorityImageSize = 4ull << 20;
   public:
     
     DxvkMemoryAllocator(DxvkDevice* device);
@@ -1332,6 +1393,9 @@ namespace dxvk {
     alignas(CACHE_LINE_SIZE)
     DxvkRelocationList        m_relocations;
 
+    std::ofstream             m_traceFile;
+    high_resolution_clock::time_point m_traceStart = { };
+
     DxvkDeviceMemory allocateDeviceMemory(
             DxvkMemoryType&       type,
             VkDeviceSize          size,
@@ -1352,6 +1416,12 @@ namespace dxvk {
             DxvkMemoryType&       type,
             DxvkDeviceMemory      memory);
 
+    void openTraceFile();
+
+    void traceAllocationLocked(
+            DxvkMemoryTraceEvent  event,
+      const DxvkResourceAllocation* allocation);
+
     void freeAllocation(
             DxvkResourceAllocation* allocation);
 
@@ -1387,6 +1457,9 @@ namespace dxvk {
             DxvkDeviceMemory&     memory,
             VkMemoryPropertyFlags properties);
 
+    void adviseHugePages(
+      const DxvkDeviceMemory&     memory);
+
     DxvkResourceAllocation* createAllocation(
             DxvkMemoryType&       type,
             DxvkMemoryPool&       pool,
@@ -25,22 +25,6 @@ namespace dxvk {
     // Create pipeline layouts using those descriptor set layouts
     m_clearBufPipeLayout = createPipelineLayout(m_clearBufDsetLayout);
     m_clearImgPipeLayout = createPipelineLayout(m_clearImgDsetLayout);
-    
-    // Create the actual compute pipelines
-    m_clearPipesF32.clearBuf = createPipeline(dxvk_clear_buffer_f, m_clearBufPipeLayout);
-    m_clearPipesU32.clearBuf = createPipeline(dxvk_clear_buffer_u, m_clearBufPipeLayout);
-    
-    m_clearPipesF32.clearImg1D = createPipeline(dxvk_clear_image1d_f, m_clearImgPipeLayout);
-    m_clearPipesU32.clearImg1D = createPipeline(dxvk_clear_image1d_u, m_clearImgPipeLayout);
-    m_clearPipesF32.clearImg2D = createPipeline(dxvk_clear_image2d_f, m_clearImgPipeLayout);
-    m_clearPipesU32.clearImg2D = createPipeline(dxvk_clear_image2d_u, m_clearImgPipeLayout);
-    m_clearPipesF32.clearImg3D = createPipeline(dxvk_clear_image3d_f, m_clearImgPipeLayout);
-    m_clearPipesU32.clearImg3D = createPipeline(dxvk_clear_image3d_u, m_clearImgPipeLayout);
-    
-    m_clearPipesF32.clearImg1DArray = createPipeline(dxvk_clear_image1darr_f, m_clearImgPipeLayout);
-    m_clearPipesU32.clearImg1DArray = createPipeline(dxvk_clear_image1darr_u, m_clearImgPipeLayout);
-    m_clearPipesF32.clearImg2DArray = createPipeline(dxvk_clear_image2darr_f, m_clearImgPipeLayout);
-    m_clearPipesU32.clearImg2DArray = createPipeline(dxvk_clear_image2darr_u, m_clearImgPipeLayout);
   }
   
   
@@ -72,44 +56,104 @@ namespace dxvk {
   
   
   DxvkMetaClearPipeline DxvkMetaClearObjects::getClearBufferPipeline(
-          DxvkFormatFlags       formatFlags) const {
+          DxvkFormatFlags       formatFlags) {
+    bool isInteger = formatFlags.any(DxvkFormatFlag::SampledUInt, DxvkFormatFlag::SampledSInt);
+    DxvkMetaClearPipelines& pipes = isInteger ? m_clearPipesU32 : m_clearPipesF32;
+
     DxvkMetaClearPipeline result;
     result.dsetLayout = m_clearBufDsetLayout;
     result.pipeLayout = m_clearBufPipeLayout;
-    result.pipeline   = m_clearPipesF32.clearBuf;
-    
-    if (formatFlags.any(DxvkFormatFlag::SampledUInt, DxvkFormatFlag::SampledSInt))
-      result.pipeline = m_clearPipesU32.clearBuf;
-    
     result.workgroupSize = VkExtent3D { 128, 1, 1 };
+
+    std::lock_guard lock(m_mutex);
+
+    if (!pipes.clearBuf) {
+      pipes.clearBuf = isInteger
+        ? createPipeline(dxvk_clear_buffer_u, m_clearBufPipeLayout)
+        : createPipeline(dxvk_clear_buffer_f, m_clearBufPipeLayout);
+    }
+
+    result.pipeline = pipes.clearBuf;
     return result;
   }
   
   
   DxvkMetaClearPipeline DxvkMetaClearObjects::getClearImagePipeline(
           VkImageViewType       viewType,
-          DxvkFormatFlags       formatFlags) const {
-    const DxvkMetaClearPipelines& pipes = formatFlags.any(
-      DxvkFormatFlag::SampledUInt, DxvkFormatFlag::SampledSInt)
-        ? m_clearPipesU32 : m_clearPipesF32;
-    
+          DxvkFormatFlags       formatFlags) {
+    bool isInteger = formatFlags.any(DxvkFormatFlag::SampledUInt, DxvkFormatFlag::SampledSInt);
+    DxvkMetaClearPipelines& pipes = isInteger ? m_clearPipesU32 : m_clearPipesF32;
+
     DxvkMetaClearPipeline result;
     result.dsetLayout = m_clearImgDsetLayout;
     result.pipeLayout = m_clearImgPipeLayout;
-    
-    auto pipeInfo = [&pipes, viewType] () -> std::pair<VkPipeline, VkExtent3D> {
-      switch (viewType) {
-        case VK_IMAGE_VIEW_TYPE_1D:       return { pipes.clearImg1D,      VkExtent3D { 64, 1, 1 } };
-        case VK_IMAGE_VIEW_TYPE_2D:       return { pipes.clearImg2D,      VkExtent3D {  8, 8, 1 } };
-        case VK_IMAGE_VIEW_TYPE_3D:       return { pipes.clearImg3D,      VkExtent3D {  4, 4, 4 } };
-        case VK_IMAGE_VIEW_TYPE_1D_ARRAY: return { pipes.clearImg1DArray, VkExtent3D { 64, 1, 1 } };
-        case VK_IMAGE_VIEW_TYPE_2D_ARRAY: return { pipes.clearImg2DArray, VkExtent3D {  8, 8, 1 } };
-        default:                          return { VkPipeline(VK_NULL_HANDLE), VkExtent3D { 0, 0, 0, } };
-      }
-    }();
-    
-    result.pipeline      = pipeInfo.first;
-    result.workgroupSize = pipeInfo.second;
+    result.pipeline = VK_NULL_HANDLE;
+    result.workgroupSize = VkExtent3D { 0, 0, 0 };
+
+    // Pipelines are created on first use since most
+    // applications only ever need a small subset
+    std::lock_guard lock(m_mutex);
+
+    switch (viewType) {
+      case VK_IMAGE_VIEW_TYPE_1D:
+        if (!pipes.clearImg1D) {
+          pipes.clearImg1D = isInteger
+            ? createPipeline(dxvk_clear_image1d_u, m_clearImgPipeLayout)
+            : createPipeline(dxvk_clear_image1d_f, m_clearImgPipeLayout);
+        }
+
+        result.pipeline = pipes.clearImg1D;
+        result.workgroupSize = VkExtent3D { 64, 1, 1 };
+        break;
+
+      case VK_IMAGE_VIEW_TYPE_2D:
+        if (!pipes.clearImg2D) {
+          pipes.clearImg2D = isInteger
+            ? createPipeline(dxvk_clear_image2d_u, m_clearImgPipeLayout)
+            : createPipeline(dxvk_clear_image2d_f, m_clearImgPipeLayout);
+        }
+
+        result.pipeline = pipes.clearImg2D;
+        result.workgroupSize = VkExtent3D { 8, 8, 1 };
+        break;
+
+      case VK_IMAGE_VIEW_TYPE_3D:
+        if (!pipes.clearImg3D) {
+          pipes.clearImg3D = isInteger
+            ? createPipeline(dxvk_clear_image3d_u, m_clearImgPipeLayout)
+            : createPipeline(dxvk_clear_image3d_f, m_clearImgPipeLayout);
+        }
+
+        result.pipeline = pipes.clearImg3D;
+        result.workgroupSize = VkExtent3D { 4, 4, 4 };
+        break;
+
+      case VK_IMAGE_VIEW_TYPE_1D_ARRAY:
+        if (!pipes.clearImg1DArray) {
+          pipes.clearImg1DArray = isInteger
+            ? createPipeline(dxvk_clear_image1darr_u, m_clearImgPipeLayout)
+            : createPipeline(dxvk_clear_image1darr_f, m_clearImgPipeLayout);
+        }
+
+        result.pipeline = pipes.clearImg1DArray;
+        result.workgroupSize = VkExtent3D { 64, 1, 1 };
+        break;
+
+      case VK_IMAGE_VIEW_TYPE_2D_ARRAY:
+        if (!pipes.clearImg2DArray) {
+          pipes.clearImg2DArray = isInteger
+            ? createPipeline(dxvk_clear_image2darr_u, m_clearImgPipeLayout)
+            : createPipeline(dxvk_clear_image2darr_f, m_clearImgPipeLayout);
+        }
+
+        result.pipeline = pipes.clearImg2DArray;
+        result.workgroupSize = VkExtent3D { 8, 8, 1 };
+        break;
+
+      default:
+        break;
+    }
+
     return result;
   }
   
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <mutex>
+
 #include "dxvk_format.h"
 #include "dxvk_include.h"
 
 #include "../spirv/spirv_code_buffer.h"
 
+#include "../util/thread.h"
+
 namespace dxvk {
 
   class DxvkDevice;
@@ -41,7 +45,8 @@ namespace dxvk {
    * 
    * Creates the shaders, pipeline layouts, and
    * compute pipelines that are going to be used
-   * for clear operations.
+   * for clear operations. Pipelines are created
+   * on demand.
    */
   class DxvkMetaClearObjects {
     
@@ -59,7 +64,7 @@ namespace dxvk {
      * \param [in] viewType The image virw type
      */
     DxvkMetaClearPipeline getClearBufferPipeline(
-            DxvkFormatFlags       formatFlags) const;
+            DxvkFormatFlags       formatFlags);
     
     /**
      * \brief Retrieves objects for a given image view type
@@ -72,7 +77,7 @@ namespace dxvk {
      */
     DxvkMetaClearPipeline getClearImagePipeline(
             VkImageViewType       viewType,
-            DxvkFormatFlags       formatFlags) const;
+            DxvkFormatFlags       formatFlags);
     
   private:
     
@@ -86,6 +91,8 @@ namespace dxvk {
     };
     
     Rc<vk::DeviceFn> m_vkd;
+
+    dxvk::mutex m_mutex;
     
     VkDescriptorSetLayout m_clearBufDsetLayout = VK_NULL_HANDLE;
     VkDescriptorSetLayout m_clearImgDsetLayout = VK_NULL_HANDLE;
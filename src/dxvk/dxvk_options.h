@@ -14,6 +14,9 @@ namespace dxvk {
     /// Enable state cache
     bool enableStateCache = true;
 
+    /// Enable persistent Vulkan pipeline cache
+    bool enablePipelineCache = false;
+
     /// Enable memory defragmentation
     Tristate enableMemoryDefrag = Tristate::Auto;
 
@@ -21,6 +24,10 @@ namespace dxvk {
     /// when using the state cache
     int32_t numCompilerThreads = 0;
 
+    /// Maximum number of compiler threads that
+    /// can work on background pipelines at once
+    int32_t numBackgroundCompilerThreads = 0;
+
     /// Enable graphics pipeline library
     Tristate enableGraphicsPipelineLibrary = Tristate::Auto;
 
@@ -55,6 +62,10 @@ namespace dxvk {
     /// Clears all mapped memory to zero.
     bool zeroMappedMemory = false;
 
+    /// Requests transparent huge pages for large mapped chunks.
+    /// Only has an effect in native Linux builds.
+    bool hugePageMappings = false;
+
     /// Allows full-screen exclusive mode on Windows
     bool allowFse = false;
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <optional>
 
 #include "dxvk_device.h"
@@ -95,6 +96,15 @@ namespace dxvk {
       if (m_device->config().numCompilerThreads > 0)
         workerCount = m_device->config().numCompilerThreads;
 
+      // Limit the number of threads that can work on background tasks
+      // at the same time so that the app's own threads do not have to
+      // compete with pipeline compilation, especially on CPUs with a
+      // low core count. High-priority work is not affected.
+      m_backgroundTasksMax = std::max(dxvk::thread::hardware_concurrency(), 3u) - 2u;
+
+      if (m_device->config().numBackgroundCompilerThreads > 0)
+        m_backgroundTasksMax = m_device->config().numBackgroundCompilerThreads;
+
       // Number of workers that can process pipeline pipelines with normal
       // priority. Any other workers can only build high-priority pipelines.
       uint32_t npWorkerCount = std::max(((workerCount - 1) * 5) / 7, 1u);
@@ -130,20 +140,41 @@ namespace dxvk {
     const uint32_t maxPriorityIndex = uint32_t(maxPriority);
     env::setThreadName(str::format("dxvk-shader-", suffixes.at(maxPriorityIndex)));
 
+    bool isBackgroundTask = false;
+
     while (true) {
       PipelineEntry entry;
 
       { std::unique_lock lock(m_lock);
         auto& bucket = m_buckets[maxPriorityIndex];
 
+        // Low-priority workers may have skipped work while we were
+        // at the background task limit, so make sure they wake up
+        if (std::exchange(isBackgroundTask, false)) {
+          if (m_backgroundTasksActive-- >= m_backgroundTasksMax
+           && !m_buckets[uint32_t(DxvkPipelinePriority::Low)].queue.empty())
+            notifyWorkers(DxvkPipelinePriority::Low);
+        }
+
         bucket.idleWorkers += 1;
-        bucket.cond.wait(lock, [this, maxPriorityIndex, &entry] {
+        bucket.cond.wait(lock, [this, maxPriorityIndex, &entry, &isBackgroundTask] {
           // Attempt to fetch a work item from the
           // highest-priority queue that is not empty
           for (uint32_t i = 0; i <= maxPriorityIndex; i++) {
+            bool isBackground = i != uint32_t(DxvkPipelinePriority::High);
+
+            if (isBackground && m_backgroundTasksActive >= m_backgroundTasksMax)
+              break;
+
             if (!m_buckets[i].queue.empty()) {
               entry = m_buckets[i].queue.front();
               m_buckets[i].queue.pop();
+
+              if (isBackground) {
+                m_backgroundTasksActive += 1;
+                isBackgroundTask = true;
+              }
+
               return true;
             }
           }
@@ -370,6 +401,52 @@ namespace dxvk {
   }
 
 
+  void DxvkPipelineStats::recordCompileTime(
+    const char*                 type,
+    const std::string&          name,
+          std::chrono::microseconds time) {
+    uint64_t us = time.count();
+    uint32_t bucket = 0u;
+
+    while (bucket < DxvkPipelineCompileTimes::BucketLimits.size()
+        && us >= DxvkPipelineCompileTimes::BucketLimits[bucket])
+      bucket += 1u;
+
+    compileTimeHistogram[bucket] += 1u;
+
+    if (us >= SlowCompileThreshold)
+      Logger::info(str::format("Slow ", type, " pipeline compile (", us / 1000u, " ms): ", name));
+
+    std::lock_guard lock(compileTimeMutex);
+
+    if (compileTimeSlowest.size() < DxvkPipelineCompileTimes::SlowestCount || us > compileTimeSlowest.back().us) {
+      auto entry = std::find_if(compileTimeSlowest.begin(), compileTimeSlowest.end(),
+        [us] (const DxvkPipelineCompileTime& e) { return e.us < us; });
+
+      DxvkPipelineCompileTime newEntry;
+      newEntry.name = str::format(type, " ", name);
+      newEntry.us = us;
+
+      compileTimeSlowest.insert(entry, std::move(newEntry));
+
+      if (compileTimeSlowest.size() > DxvkPipelineCompileTimes::SlowestCount)
+        compileTimeSlowest.pop_back();
+    }
+  }
+
+
+  DxvkPipelineCompileTimes DxvkPipelineStats::getCompileTimes() {
+    DxvkPipelineCompileTimes result;
+
+    for (uint32_t i = 0; i < DxvkPipelineCompileTimes::BucketCount; i++)
+      result.histogram[i] = compileTimeHistogram[i].load();
+
+    std::lock_guard lock(compileTimeMutex);
+    result.slowest = compileTimeSlowest;
+    return result;
+  }
+
+
   DxvkPipelineCount DxvkPipelineManager::getPipelineCount() const {
     DxvkPipelineCount result;
     result.numGraphicsPipelines = m_stats.numGraphicsPipelines.load();
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <mutex>
 #include <queue>
 #include <unordered_map>
@@ -25,13 +27,67 @@ namespace dxvk {
     uint32_t numComputePipelines;
   };
 
+  /**
+   * \brief Pipeline compile time entry
+   */
+  struct DxvkPipelineCompileTime {
+    std::string name;
+    uint64_t    us = 0u;
+  };
+
+  /**
+   * \brief Pipeline compile time statistics
+   *
+   * Stores a histogram of pipeline compile times,
+   * in microseconds, as well as the slowest
+   * pipelines compiled so far.
+   */
+  struct DxvkPipelineCompileTimes {
+    constexpr static uint32_t BucketCount = 6u;
+    constexpr static uint32_t SlowestCount = 8u;
+
+    constexpr static std::array<uint64_t, BucketCount - 1u> BucketLimits = {
+      1000u, 5000u, 20000u, 50000u, 200000u,
+    };
+
+    std::array<uint32_t, BucketCount> histogram = { };
+    std::vector<DxvkPipelineCompileTime> slowest;
+  };
+
   /**
    * \brief Pipeline stats
    */
   struct DxvkPipelineStats {
+    constexpr static uint64_t SlowCompileThreshold = 100000u;
+
     std::atomic<uint32_t> numGraphicsPipelines  = { 0u };
     std::atomic<uint32_t> numGraphicsLibraries  = { 0u };
     std::atomic<uint32_t> numComputePipelines   = { 0u };
+
+    std::array<std::atomic<uint32_t>, DxvkPipelineCompileTimes::BucketCount> compileTimeHistogram = { };
+
+    dxvk::mutex                           compileTimeMutex;
+    std::vector<DxvkPipelineCompileTime>  compileTimeSlowest;
+
+    /**
+     * \brief Records compile time of a pipeline
+     *
+     * Pipelines that take particularly long to compile
+     * are also written to the log.
+     * \param [in] type Pipeline type, for logging
+     * \param [in] name Pipeline debug name
+     * \param [in] time Time spent compiling
+     */
+    void recordCompileTime(
+      const char*                 type,
+      const std::string&          name,
+            std::chrono::microseconds time);
+
+    /**
+     * \brief Queries compile time statistics
+     * \returns Histogram and slowest pipelines
+     */
+    DxvkPipelineCompileTimes getCompileTimes();
   };
 
   struct DxvkPipelineWorkerStats {
@@ -142,6 +198,9 @@ namespace dxvk {
     bool                              m_workersRunning = false;
     std::vector<dxvk::thread>         m_workers;
 
+    uint32_t                          m_backgroundTasksActive = 0u;
+    uint32_t                          m_backgroundTasksMax    = 0u;
+
     void notifyWorkers(DxvkPipelinePriority priority);
 
     void startWorkers();
@@ -251,6 +310,14 @@ namespace dxvk {
      */
     DxvkPipelineCount getPipelineCount() const;
 
+    /**
+     * \brief Retrieves pipeline compile time statistics
+     * \returns Compile time histogram and slowest pipelines
+     */
+    DxvkPipelineCompileTimes getCompileTimes() {
+      return m_stats.getCompileTimes();
+    }
+
     /**
      * \brief Checks whether async compiler is busy
      * \returns \c true if shaders are being compiled
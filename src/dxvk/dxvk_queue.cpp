@@ -207,10 +207,6 @@ namespace dxvk {
 
       m_submitQueue.pop();
       m_submitCond.notify_all();
-
-      // Good time to invoke allocator tasks now since we
-      // expect this to get called somewhat periodically.
-      m_device->m_objects.memoryManager().performTimedTasks();
     }
   }
   
@@ -292,6 +288,12 @@ namespace dxvk {
         entry.submit.cmdList->reset();
         m_device->recycleCommandList(entry.submit.cmdList);
       }
+
+      // Good time to invoke allocator tasks now since we expect this
+      // to get called somewhat periodically. Doing this here rather
+      // than on the submission thread keeps potentially expensive
+      // work such as defragmentation off the submission path.
+      m_device->m_objects.memoryManager().performTimedTasks();
     }
   }
   
@@ -127,7 +127,9 @@ namespace dxvk {
   }
 
 
-  Rc<DxvkSampler> DxvkSamplerPool::createSampler(const DxvkSamplerKey& key) {
+  Rc<DxvkSampler> DxvkSamplerPool::createSampler(const DxvkSamplerKey& desc) {
+    DxvkSamplerKey key = normalizeKey(desc);
+
     std::unique_lock lock(m_mutex);
     auto entry = m_samplers.find(key);
 
@@ -175,6 +177,22 @@ namespace dxvk {
   }
 
 
+  DxvkSamplerKey DxvkSamplerPool::normalizeKey(const DxvkSamplerKey& key) const {
+    // Clear properties that have no effect on the resulting sampler,
+    // so that functionally identical keys map to the same object.
+    DxvkSamplerKey result = key;
+
+    if (result.u.p.anisotropy <= 1u
+     || !m_device->features().core.features.samplerAnisotropy)
+      result.u.p.anisotropy = 0u;
+
+    if (!m_device->features().extNonSeamlessCubeMap.nonSeamlessCubeMap)
+      result.u.p.legacyCube = 0u;
+
+    return result;
+  }
+
+
   void DxvkSamplerPool::releaseSampler(DxvkSampler* sampler) {
     std::unique_lock lock(m_mutex);
 
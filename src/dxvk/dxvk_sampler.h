@@ -284,6 +284,8 @@ namespace dxvk {
 
     void destroyLeastRecentlyUsedSampler();
 
+    DxvkSamplerKey normalizeKey(const DxvkSamplerKey& key) const;
+
   };
 
 
@@ -1015,6 +1015,7 @@ namespace dxvk {
     const DxvkBindingLayoutObjects* layout)
   : m_device      (device),
     m_stats       (&manager->m_stats),
+    m_cache       (manager->m_stateCache.getPipelineCache()),
     m_shaders     (key.getShaderSet()),
     m_layout      (layout) {
 
@@ -1103,6 +1104,8 @@ namespace dxvk {
   DxvkShaderPipelineLibraryHandle DxvkShaderPipelineLibrary::compileShaderPipelineLocked() {
     this->notifyLibraryCompile();
 
+    auto t0 = dxvk::high_resolution_clock::now();
+
     // If this is not the first time we're compiling the pipeline,
     // try to get a cache hit using the shader module identifier
     // so that we don't have to decompress our SPIR-V shader again.
@@ -1118,6 +1121,22 @@ namespace dxvk {
     if (!pipeline.handle)
       return { VK_NULL_HANDLE, 0 };
 
+    auto t1 = dxvk::high_resolution_clock::now();
+
+    std::array<DxvkShader*, 6> shaders = {{
+      m_shaders.vs, m_shaders.tcs, m_shaders.tes,
+      m_shaders.gs, m_shaders.fs,  m_shaders.cs,
+    }};
+    std::string name;
+
+    for (auto shader : shaders) {
+      if (shader)
+        name += str::format("[", shader->debugName(), "] ");
+    }
+
+    m_stats->recordCompileTime("library", name,
+      std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0));
+
     // Increment stat counter the first time this
     // shader pipeline gets compiled successfully
     if (!m_compiledOnce) {
@@ -1251,7 +1270,7 @@ namespace dxvk {
     info.basePipelineIndex    = -1;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), VK_NULL_HANDLE, 1, &info, nullptr, &pipeline);
+    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), m_cache, 1, &info, nullptr, &pipeline);
 
     if (vr && vr != VK_PIPELINE_COMPILE_REQUIRED_EXT)
       Logger::err(str::format("DxvkShaderPipelineLibrary: Failed to create vertex shader pipeline: ", vr));
@@ -1340,7 +1359,7 @@ namespace dxvk {
       info.pMultisampleState  = &msInfo;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), VK_NULL_HANDLE, 1, &info, nullptr, &pipeline);
+    VkResult vr = vk->vkCreateGraphicsPipelines(vk->device(), m_cache, 1, &info, nullptr, &pipeline);
 
     if (vr && !(flags & VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT))
       Logger::err(str::format("DxvkShaderPipelineLibrary: Failed to create fragment shader pipeline: ", vr));
@@ -1362,7 +1381,7 @@ namespace dxvk {
     info.basePipelineIndex = -1;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    VkResult vr = vk->vkCreateComputePipelines(vk->device(), VK_NULL_HANDLE, 1, &info, nullptr, &pipeline);
+    VkResult vr = vk->vkCreateComputePipelines(vk->device(), m_cache, 1, &info, nullptr, &pipeline);
 
     if (vr && vr != VK_PIPELINE_COMPILE_REQUIRED_EXT)
       Logger::err(str::format("DxvkShaderPipelineLibrary: Failed to create compute shader pipeline: ", vr));
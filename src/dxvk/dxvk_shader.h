@@ -538,6 +538,7 @@ namespace dxvk {
 
     const DxvkDevice*               m_device;
           DxvkPipelineStats*        m_stats;
+          VkPipelineCache           m_cache;
           DxvkShaderSet             m_shaders;
     const DxvkBindingLayoutObjects* m_layout;
 
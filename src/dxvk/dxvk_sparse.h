@@ -513,6 +513,18 @@ namespace dxvk {
       return m_useCount.load(std::memory_order_acquire) >= getIncrement(access);
     }
 
+    /**
+     * \brief Checks whether the caller holds the only reference
+     *
+     * Returns \c true if there are no other references to the
+     * resource and no pending GPU accesses, i.e. the resource
+     * can safely be reused by the owner of the reference.
+     * \returns \c true if the resource is exclusively owned
+     */
+    force_inline bool isExclusivelyOwned() const {
+      return m_useCount.load(std::memory_order_acquire) == getIncrement(DxvkAccess::None);
+    }
+
     /**
      * \brief Tries to acquire reference
      *
@@ -38,14 +38,17 @@ namespace dxvk {
     }
 
     if (m_offset + alignedSize > m_size || m_buffer == nullptr) {
-      info.size = m_size;
+      retireBuffer();
 
-      // Free resources first if possible, in some rare
-      // situations this may help avoid a memory allocation.
-      m_buffer = nullptr;
-      m_buffer = m_device->createBuffer(info,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+      m_buffer = findRetiredBuffer();
       m_offset = 0;
+
+      if (m_buffer == nullptr) {
+        info.size = m_size;
+
+        m_buffer = m_device->createBuffer(info,
+          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+      }
     }
 
     DxvkBufferSlice slice(m_buffer, m_offset, size);
@@ -55,10 +58,37 @@ namespace dxvk {
 
 
   void DxvkStagingBuffer::reset() {
-    m_buffer = nullptr;
+    retireBuffer();
+
     m_offset = 0;
 
     m_allocationCounterValueOnReset = m_allocationCounter;
   }
-  
+
+
+  void DxvkStagingBuffer::retireBuffer() {
+    if (m_buffer == nullptr)
+      return;
+
+    m_retired.push(std::move(m_buffer));
+    m_buffer = nullptr;
+
+    // Drop the oldest buffer if too many are still in
+    // flight, the GPU will free it once it is done.
+    if (m_retired.size() > MaxRetiredBuffers)
+      m_retired.pop();
+  }
+
+
+  Rc<DxvkBuffer> DxvkStagingBuffer::findRetiredBuffer() {
+    // Buffers are retired in submission order, so only checking
+    // the oldest one is sufficient to find an idle buffer.
+    if (m_retired.empty() || !m_retired.front()->isExclusivelyOwned())
+      return nullptr;
+
+    Rc<DxvkBuffer> buffer = std::move(m_retired.front());
+    m_retired.pop();
+    return buffer;
+  }
+
 }
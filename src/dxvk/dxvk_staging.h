@@ -25,9 +25,12 @@ namespace dxvk {
    * \brief Staging buffer
    *
    * Provides a simple linear staging buffer
-   * allocator for data uploads.
+   * allocator for data uploads. Buffers that are no
+   * longer in use by the GPU are recycled.
    */
   class DxvkStagingBuffer {
+    // Maximum number of retired buffers to keep around
+    constexpr static size_t MaxRetiredBuffers = 4u;
 
   public:
 
@@ -82,6 +85,12 @@ namespace dxvk {
     VkDeviceSize    m_allocationCounter = 0u;
     VkDeviceSize    m_allocationCounterValueOnReset = 0u;
 
+    std::queue<Rc<DxvkBuffer>> m_retired;
+
+    void retireBuffer();
+
+    Rc<DxvkBuffer> findRetiredBuffer();
+
   };
 
 }
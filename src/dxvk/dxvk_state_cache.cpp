@@ -2,6 +2,8 @@
 #include "dxvk_pipemanager.h"
 #include "dxvk_state_cache.h"
 
+#include <filesystem>
+
 namespace dxvk {
 
   static const Sha1Hash       g_nullHash      = Sha1Hash::compute(nullptr, 0);
@@ -271,19 +273,23 @@ namespace dxvk {
 
     bool newFile = (useStateCache == "reset") || (!readCacheFile());
 
-    if (newFile) {
-      auto file = openCacheFileForWrite(true);
+    if (newFile)
+      recreateCacheFile();
 
-      // Write all valid entries to the cache file in
-      // case we're recovering a corrupted cache file
-      for (auto& e : m_entries)
-        writeCacheEntry(file, e);
-    }
+    if (device->config().enablePipelineCache)
+      createPipelineCache(useStateCache == "reset");
   }
   
 
   DxvkStateCache::~DxvkStateCache() {
     this->stopWorkers();
+
+    if (m_pipelineCache) {
+      writePipelineCache();
+
+      auto vk = m_device->vkd();
+      vk->vkDestroyPipelineCache(vk->device(), m_pipelineCache, nullptr);
+    }
   }
 
 
@@ -366,7 +372,9 @@ namespace dxvk {
        || !getShaderByKey(p->second.gs,  item.gp.gs)
        || !getShaderByKey(p->second.fs,  item.gp.fs))
         continue;
-      
+
+      item.firstEntry = getFirstEntryIndex(p->second);
+
       if (!workerLock)
         workerLock = std::unique_lock<dxvk::mutex>(m_workerLock);
       
@@ -425,6 +433,18 @@ namespace dxvk {
     m_entryMap.insert({ key, entryId });
   }
 
+
+  size_t DxvkStateCache::getFirstEntryIndex(
+    const DxvkStateCacheKey&        key) const {
+    auto entries = m_entryMap.equal_range(key);
+    size_t result = m_entries.size();
+
+    for (auto e = entries.first; e != entries.second; e++)
+      result = std::min(result, e->second);
+
+    return result;
+  }
+
   
   void DxvkStateCache::mapShaderToPipeline(
     const DxvkShaderKey&            shader,
@@ -448,12 +468,18 @@ namespace dxvk {
     for (auto e = entries.first; e != entries.second; e++) {
       const auto& entry = m_entries[e->second];
 
+      // Low-priority workers only exist with pipeline libraries
+      DxvkPipelinePriority priority = DxvkPipelinePriority::Normal;
+
+      if (e->second >= EarlyEntryCount && m_device->canUseGraphicsPipelineLibrary())
+        priority = DxvkPipelinePriority::Low;
+
       switch (entry.type) {
         case DxvkStateCacheEntryType::MonolithicPipeline: {
           if (!pipeline)
             pipeline = m_pipeManager->createGraphicsPipeline(item.gp);
 
-          m_pipeWorkers->compileGraphicsPipeline(pipeline, entry.gpState, DxvkPipelinePriority::Normal);
+          m_pipeWorkers->compileGraphicsPipeline(pipeline, entry.gpState, priority);
         } break;
 
         case DxvkStateCacheEntryType::PipelineLibrary: {
@@ -468,7 +494,7 @@ namespace dxvk {
           if (item.gp.gs  != nullptr) libraryKey.addShader(item.gp.gs);
 
           auto pipelineLibrary = m_pipeManager->createShaderPipelineLibrary(libraryKey);
-          m_pipeWorkers->compilePipelineLibrary(pipelineLibrary, DxvkPipelinePriority::Normal);
+          m_pipeWorkers->compilePipelineLibrary(pipelineLibrary, priority);
         } break;
       }
     }
@@ -506,17 +532,35 @@ namespace dxvk {
     if (curHeader.version != newHeader.version)
       Logger::warn(str::format("DXVK: Updating state cache version to v", newHeader.version));
 
+    // Pre-size look-up tables based on the file size in order to avoid
+    // repeatedly rehashing them for large caches. Entries are at least
+    // this large, and typically reference two shaders.
+    constexpr static size_t MinEntrySize = 128u;
+
+    std::streampos dataOffset = ifile.tellg();
+    std::streampos fileSize = ifile.seekg(0, std::ios_base::end).tellg();
+
+    if (dataOffset >= 0 && fileSize > dataOffset) {
+      size_t entryCountEstimate = size_t(fileSize - dataOffset) / MinEntrySize;
+
+      m_entryMap.reserve(entryCountEstimate);
+      m_pipelineMap.reserve(entryCountEstimate * 2u);
+    }
+
+    ifile.clear();
+    ifile.seekg(dataOffset);
+
     // Read actual cache entries from the file.
     // If we encounter invalid entries, we should
     // regenerate the entire state cache file.
     uint32_t numInvalidEntries = 0;
 
     while (ifile) {
-      DxvkStateCacheEntry entry;
+      // Parse entries in place to avoid copying them around
+      auto& entry = m_entries.emplace_back();
 
       if (readCacheEntry(curHeader.version, ifile, entry)) {
-        size_t entryId = m_entries.size();
-        m_entries.push_back(entry);
+        size_t entryId = m_entries.size() - 1u;
 
         mapPipelineToEntry(entry.shaders, entryId);
 
@@ -525,8 +569,11 @@ namespace dxvk {
         mapShaderToPipeline(entry.shaders.tes, entry.shaders);
         mapShaderToPipeline(entry.shaders.gs,  entry.shaders);
         mapShaderToPipeline(entry.shaders.fs,  entry.shaders);
-      } else if (ifile) {
-        numInvalidEntries += 1;
+      } else {
+        m_entries.pop_back();
+
+        if (ifile)
+          numInvalidEntries += 1;
       }
     }
 
@@ -546,6 +593,127 @@ namespace dxvk {
   }
 
 
+  void DxvkStateCache::recreateCacheFile() {
+    // Write the new file to a temporary location and then replace the
+    // old one, so that other processes currently appending to the same
+    // cache file never observe a truncated or partially written file.
+    str::path_string fileName = getCacheFileName();
+    str::path_string tempName = fileName + str::topath(".tmp");
+
+    { std::ofstream file(tempName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+      if (!file && env::createDirectory(getCacheDir()))
+        file = std::ofstream(tempName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+      if (!file)
+        return;
+
+      Logger::warn("DXVK: Creating new state cache file");
+
+      // Write header with the current version number
+      DxvkStateCacheHeader header;
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+      // Write all valid entries to the cache file in
+      // case we're recovering a corrupted cache file
+      for (auto& e : m_entries)
+        writeCacheEntry(file, e);
+
+      if (!file)
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempName, fileName, ec);
+
+    if (ec)
+      Logger::warn("DXVK: Failed to replace state cache file");
+  }
+
+
+  void DxvkStateCache::createPipelineCache(
+          bool                      reset) {
+    auto vk = m_device->vkd();
+
+    // The driver validates the cache header and ignores data
+    // from a different driver or device, so we can pass the
+    // file contents through without further checks.
+    std::vector<char> data;
+
+    if (!reset) {
+      std::ifstream file(getPipelineCacheFileName().c_str(),
+        std::ios_base::binary | std::ios_base::ate);
+
+      if (file) {
+        std::streampos size = file.tellg();
+
+        if (size > 0) {
+          data.resize(size_t(size));
+
+          file.seekg(0, std::ios_base::beg);
+
+          if (!file.read(data.data(), data.size()))
+            data.clear();
+        }
+      }
+    }
+
+    VkPipelineCacheCreateInfo info = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    info.initialDataSize = data.size();
+    info.pInitialData = data.data();
+
+    VkResult vr = vk->vkCreatePipelineCache(vk->device(), &info, nullptr, &m_pipelineCache);
+
+    if (vr && !data.empty()) {
+      // Retry without the initial data in case it was rejected
+      info.initialDataSize = 0;
+      info.pInitialData = nullptr;
+
+      vr = vk->vkCreatePipelineCache(vk->device(), &info, nullptr, &m_pipelineCache);
+    }
+
+    if (vr) {
+      Logger::warn(str::format("DXVK: Failed to create pipeline cache: ", vr));
+      m_pipelineCache = VK_NULL_HANDLE;
+      return;
+    }
+
+    Logger::info(str::format("DXVK: Read ", data.size(), " bytes of pipeline cache data"));
+  }
+
+
+  void DxvkStateCache::writePipelineCache() const {
+    auto vk = m_device->vkd();
+
+    size_t size = 0;
+
+    if (vk->vkGetPipelineCacheData(vk->device(), m_pipelineCache, &size, nullptr) || !size)
+      return;
+
+    std::vector<char> data(size);
+
+    if (vk->vkGetPipelineCacheData(vk->device(), m_pipelineCache, &size, data.data()))
+      return;
+
+    // Write to a temporary file first so that we never
+    // leave a truncated cache behind if we get killed
+    str::path_string fileName = getPipelineCacheFileName();
+    str::path_string tempName = fileName + str::topath(".tmp");
+
+    { std::ofstream file(tempName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+      if (!file || !file.write(data.data(), size))
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempName, fileName, ec);
+
+    if (ec)
+      Logger::warn("DXVK: Failed to write pipeline cache");
+  }
+
+
   bool DxvkStateCache::readCacheHeader(
           std::istream&             stream,
           DxvkStateCacheHeader&     header) const {
@@ -758,9 +926,17 @@ namespace dxvk {
 
     Sha1Hash hash = data.computeHash();
 
-    stream.write(reinterpret_cast<char*>(&header), sizeof(header));
-    stream.write(reinterpret_cast<char*>(&hash), sizeof(hash));
-    stream.write(data.data(), data.size());
+    // Emit the entry with a single write. This makes it less likely
+    // for entries from multiple processes appending to the same file
+    // to get interleaved, but is not guaranteed to prevent it; broken
+    // entries fail the hash check on load and the file gets rewritten
+    // through a temporary file that then replaces the old one.
+    std::vector<char> buffer(sizeof(header) + sizeof(hash) + data.size());
+    std::memcpy(&buffer[0], &header, sizeof(header));
+    std::memcpy(&buffer[sizeof(header)], &hash, sizeof(hash));
+    std::memcpy(&buffer[sizeof(header) + sizeof(hash)], data.data(), data.size());
+
+    stream.write(buffer.data(), buffer.size());
     stream.flush();
   }
 
@@ -783,7 +959,7 @@ namespace dxvk {
         if (m_workerQueue.empty())
           break;
         
-        item = m_workerQueue.front();
+        item = m_workerQueue.top();
         m_workerQueue.pop();
       }
 
@@ -895,6 +1071,18 @@ namespace dxvk {
   }
 
 
+  str::path_string DxvkStateCache::getPipelineCacheFileName() const {
+    std::string path = getCacheDir();
+
+    if (!path.empty() && *path.rbegin() != '/')
+      path += '/';
+
+    std::string exeName = env::getExeBaseName();
+    path += exeName + ".dxvk-pipecache";
+    return str::topath(path.c_str());
+  }
+
+
   std::string DxvkStateCache::getCacheDir() const {
     return env::getEnvVar("DXVK_STATE_CACHE_PATH");
   }
@@ -74,12 +74,38 @@ namespace dxvk {
      */
     void stopWorkers();
 
+    /**
+     * \brief Queries Vulkan pipeline cache
+     *
+     * The pipeline cache is loaded from disk when the
+     * state cache is created, and written back when it
+     * is destroyed. May be \c VK_NULL_HANDLE.
+     * \returns Pipeline cache handle
+     */
+    VkPipelineCache getPipelineCache() const {
+      return m_pipelineCache;
+    }
+
   private:
 
     using WriterItem = DxvkStateCacheEntry;
 
+    /// Number of cached pipelines to compile at normal priority.
+    /// Since entries are appended to the cache file in the order
+    /// in which pipelines were first used, these are the ones that
+    /// are most likely needed at game start, so any remaining
+    /// pipelines are compiled at low priority instead.
+    constexpr static size_t EarlyEntryCount = 1024u;
+
     struct WorkerItem {
       DxvkGraphicsPipelineShaders gp;
+      size_t                      firstEntry = 0u;
+    };
+
+    struct WorkerItemOrder {
+      bool operator () (const WorkerItem& a, const WorkerItem& b) const {
+        return a.firstEntry > b.firstEntry;
+      }
     };
 
     DxvkDevice*                       m_device;
@@ -87,6 +113,8 @@ namespace dxvk {
     DxvkPipelineWorkers*              m_pipeWorkers;
     bool                              m_enable = false;
 
+    VkPipelineCache                   m_pipelineCache = VK_NULL_HANDLE;
+
     std::vector<DxvkStateCacheEntry>  m_entries;
     std::atomic<bool>                 m_stopThreads = { false };
 
@@ -106,7 +134,9 @@ namespace dxvk {
 
     dxvk::mutex                       m_workerLock;
     dxvk::condition_variable          m_workerCond;
-    std::queue<WorkerItem>            m_workerQueue;
+    std::priority_queue<WorkerItem,
+      std::vector<WorkerItem>,
+      WorkerItemOrder>                m_workerQueue;
     dxvk::thread                      m_workerThread;
 
     dxvk::mutex                       m_writerLock;
@@ -125,6 +155,9 @@ namespace dxvk {
       const DxvkStateCacheKey&        key,
             size_t                    entryId);
     
+    size_t getFirstEntryIndex(
+      const DxvkStateCacheKey&        key) const;
+
     void mapShaderToPipeline(
       const DxvkShaderKey&            shader,
       const DxvkStateCacheKey&        key);
@@ -134,6 +167,13 @@ namespace dxvk {
 
     bool readCacheFile();
 
+    void recreateCacheFile();
+
+    void createPipelineCache(
+            bool                      reset);
+
+    void writePipelineCache() const;
+
     bool readCacheHeader(
             std::istream&             stream,
             DxvkStateCacheHeader&     header) const;
@@ -157,6 +197,8 @@ namespace dxvk {
 
     str::path_string getCacheFileName() const;
 
+    str::path_string getPipelineCacheFileName() const;
+
     std::ifstream openCacheFileForRead() const;
 
     std::ofstream openCacheFileForWrite(
@@ -2,6 +2,8 @@
 
 #include "dxvk_include.h"
 
+#include "../util/util_time.h"
+
 namespace dxvk {
   
   /**
@@ -30,6 +32,10 @@ namespace dxvk {
     CsChunkCount,             ///< Submitted CS chunks
     DescriptorPoolCount,      ///< Descriptor pool count
     DescriptorSetCount,       ///< Descriptor sets allocated
+    CmdPipelineTicks,         ///< Time spent updating graphics pipelines, in ns
+    CmdBindingTicks,          ///< Time spent updating resource bindings, in ns
+    CmdBarrierTicks,          ///< Time spent on graphics hazard tracking, in ns
+    CmdVertexBufferTicks,     ///< Time spent binding vertex buffers, in ns
     NumCounters,              ///< Number of counters available
   };
   
@@ -115,5 +121,44 @@ namespace dxvk {
     std::array<uint64_t, uint32_t(DxvkStatCounter::NumCounters)> m_counters;
     
   };
+
+
+  /**
+   * \brief Scoped stat timer
+   *
+   * Adds the time spent in the current scope, in nanoseconds,
+   * to the given counter. Does nothing if no counter set is
+   * provided, so that the overhead is only paid on demand.
+   */
+  class DxvkStatTimer {
+
+  public:
+
+    DxvkStatTimer(
+            DxvkStatCounters*         counters,
+            DxvkStatCounter           ctr)
+    : m_counters(counters), m_ctr(ctr) {
+      if (unlikely(m_counters))
+        m_start = dxvk::high_resolution_clock::now();
+    }
+
+    ~DxvkStatTimer() {
+      if (unlikely(m_counters)) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          dxvk::high_resolution_clock::now() - m_start);
+        m_counters->addCtr(m_ctr, ns.count());
+      }
+    }
+
+    DxvkStatTimer             (const DxvkStatTimer&) = delete;
+    DxvkStatTimer& operator = (const DxvkStatTimer&) = delete;
+
+  private:
+
+    DxvkStatCounters*                       m_counters;
+    DxvkStatCounter                         m_ctr;
+    dxvk::high_resolution_clock::time_point m_start;
+
+  };
   
 }
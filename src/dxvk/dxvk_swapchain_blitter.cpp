@@ -77,6 +77,12 @@ namespace dxvk {
         srcView->image()->info().extent.height };
     }
 
+    // Skip the draw entirely if the blit would be an identity copy
+    if (canCopyDirect(dstView, dstRect, srcView, srcRect)) {
+      performCopy(ctx, dstView, srcView);
+      return;
+    }
+
     if (m_gammaBuffer)
       uploadGammaImage(ctx);
 
@@ -411,6 +417,118 @@ namespace dxvk {
   }
 
 
+  bool DxvkSwapchainBlitter::canCopyDirect(
+    const Rc<DxvkImageView>&          dstView,
+          VkRect2D                    dstRect,
+    const Rc<DxvkImageView>&          srcView,
+          VkRect2D                    srcRect) const {
+    if ((m_hud && !m_hud->empty()) || m_gammaBuffer || m_gammaView || m_cursorBuffer || m_cursorView)
+      return false;
+
+    const auto& dstInfo = dstView->image()->info();
+    const auto& srcInfo = srcView->image()->info();
+
+    if (srcInfo.sampleCount != VK_SAMPLE_COUNT_1_BIT
+     || srcInfo.format != dstInfo.format
+     || srcInfo.colorSpace != dstInfo.colorSpace
+     || srcView->info().format != dstView->info().format)
+      return false;
+
+    if (!(srcInfo.usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+     || !(dstInfo.usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT))
+      return false;
+
+    // Both rects must cover the full images, otherwise we'd
+    // need to scale, clear or offset the source image
+    VkExtent3D dstExtent = dstView->mipLevelExtent(0u);
+    VkExtent3D srcExtent = srcView->mipLevelExtent(0u);
+
+    return dstRect.offset.x == 0 && dstRect.offset.y == 0
+        && srcRect.offset.x == 0 && srcRect.offset.y == 0
+        && dstRect.extent == srcRect.extent
+        && dstRect.extent.width == dstExtent.width
+        && dstRect.extent.height == dstExtent.height
+        && srcRect.extent.width == srcExtent.width
+        && srcRect.extent.height == srcExtent.height;
+  }
+
+
+  void DxvkSwapchainBlitter::performCopy(
+    const DxvkContextObjects&         ctx,
+    const Rc<DxvkImageView>&          dstView,
+    const Rc<DxvkImageView>&          srcView) {
+    const auto& dstInfo = dstView->image()->info();
+    const auto& srcInfo = srcView->image()->info();
+
+    VkImageLayout srcLayout = srcView->image()->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    VkImageLayout dstLayout = dstView->image()->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    std::array<VkImageMemoryBarrier2, 2> barriers = { };
+
+    for (auto& b : barriers) {
+      b.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+      b.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      b.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    }
+
+    barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[0].dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barriers[0].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barriers[0].newLayout = dstLayout;
+    barriers[0].image = dstView->image()->handle();
+    barriers[0].subresourceRange = dstView->imageSubresources();
+
+    barriers[1].srcStageMask = srcInfo.stages;
+    barriers[1].srcAccessMask = srcInfo.access;
+    barriers[1].dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[1].dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+    barriers[1].oldLayout = srcInfo.layout;
+    barriers[1].newLayout = srcLayout;
+    barriers[1].image = srcView->image()->handle();
+    barriers[1].subresourceRange = srcView->imageSubresources();
+
+    VkDependencyInfo depInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    depInfo.imageMemoryBarrierCount = barriers.size();
+    depInfo.pImageMemoryBarriers = barriers.data();
+
+    ctx.cmd->cmdPipelineBarrier(DxvkCmdBuffer::ExecBuffer, &depInfo);
+
+    VkImageCopy2 region = { VK_STRUCTURE_TYPE_IMAGE_COPY_2 };
+    region.srcSubresource = vk::pickSubresourceLayers(srcView->imageSubresources(), 0u);
+    region.dstSubresource = vk::pickSubresourceLayers(dstView->imageSubresources(), 0u);
+    region.extent = dstView->mipLevelExtent(0u);
+
+    VkCopyImageInfo2 copyInfo = { VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2 };
+    copyInfo.srcImage = srcView->image()->handle();
+    copyInfo.srcImageLayout = srcLayout;
+    copyInfo.dstImage = dstView->image()->handle();
+    copyInfo.dstImageLayout = dstLayout;
+    copyInfo.regionCount = 1;
+    copyInfo.pRegions = &region;
+
+    ctx.cmd->cmdCopyImage(DxvkCmdBuffer::ExecBuffer, &copyInfo);
+
+    barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[0].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    barriers[0].dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    barriers[0].oldLayout = dstLayout;
+    barriers[0].newLayout = dstInfo.layout;
+
+    barriers[1].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[1].srcAccessMask = VK_ACCESS_2_NONE;
+    barriers[1].dstStageMask = srcInfo.stages;
+    barriers[1].dstAccessMask = srcInfo.access;
+    barriers[1].oldLayout = srcLayout;
+    barriers[1].newLayout = srcInfo.layout;
+
+    ctx.cmd->cmdPipelineBarrier(DxvkCmdBuffer::ExecBuffer, &depInfo);
+
+    ctx.cmd->track(srcView->image(), DxvkAccess::Read);
+    ctx.cmd->track(dstView->image(), DxvkAccess::Write);
+  }
+
+
   void DxvkSwapchainBlitter::renderHudImage(
     const DxvkContextObjects&         ctx,
           VkExtent3D                  extent) {
@@ -262,6 +262,17 @@ namespace dxvk {
             VkRect2D                    srcRect,
             VkBool32                    composite);
 
+    bool canCopyDirect(
+      const Rc<DxvkImageView>&          dstView,
+            VkRect2D                    dstRect,
+      const Rc<DxvkImageView>&          srcView,
+            VkRect2D                    srcRect) const;
+
+    void performCopy(
+      const DxvkContextObjects&         ctx,
+      const Rc<DxvkImageView>&          dstView,
+      const Rc<DxvkImageView>&          srcView);
+
     void renderHudImage(
       const DxvkContextObjects&         ctx,
             VkExtent3D                  extent);
@@ -17,6 +17,7 @@ namespace dxvk::hud {
     addItem<HudDeviceInfoItem>("devinfo", -1, m_device);
     addItem<HudFpsItem>("fps", -1);
     addItem<HudFrameTimeItem>("frametimes", -1, device, &m_renderer);
+    addItem<HudFrameStatsItem>("framestats", -1, m_hudItems.getOption<float>("framestatswindow", 10.0f));
     addItem<HudSubmissionStatsItem>("submissions", -1, device);
     addItem<HudDrawCallStatsItem>("drawcalls", -1, device);
     addItem<HudPipelineStatsItem>("pipelines", -1, device);
@@ -24,8 +25,11 @@ namespace dxvk::hud {
     addItem<HudMemoryStatsItem>("memory", -1, device);
     addItem<HudMemoryDetailsItem>("allocations", -1, device, &m_renderer);
     addItem<HudCsThreadItem>("cs", -1, device);
+    addItem<HudCmdTimingItem>("cmdtimings", -1, device);
+    addItem<HudStutterItem>("stutter", -1, device);
     addItem<HudGpuLoadItem>("gpuload", -1, device);
     addItem<HudCompilerActivityItem>("compiler", -1, device);
+    addItem<HudCompileTimeItem>("compiletimes", -1, device);
   }
 
 
@@ -10,6 +10,7 @@
 #include <hud_graph_frag.h>
 #include <hud_graph_vert.h>
 
+#include <algorithm>
 #include <iomanip>
 #include <version.h>
 
@@ -68,6 +69,13 @@ namespace dxvk::hud {
   }
 
 
+  bool HudItemSet::isPartOfFull(const char* name) {
+    // Command timings add overhead to command recording, so they
+    // need to be enabled explicitly even if all items are shown
+    return std::string(name) != "cmdtimings";
+  }
+
+
   void HudItemSet::update() {
     auto time = dxvk::high_resolution_clock::now();
 
@@ -219,6 +227,147 @@ namespace dxvk::hud {
   }
 
 
+  HudFrameStatsItem::HudFrameStatsItem(float window)
+  : m_window(uint64_t(std::clamp(window, 1.0f, 600.0f) * 1000000.0f)) {
+    std::string path = env::getEnvVar("DXVK_HUD_FRAMESTATS_LOG");
+
+    if (!path.empty()) {
+      m_log = std::ofstream(str::topath(path.c_str()).c_str(), std::ios_base::trunc);
+
+      if (m_log) {
+        m_log << "time_ms,frames,avg_us,p99_us,p999_us";
+
+        for (uint32_t i = 0; i < BucketCount - 1u; i++)
+          m_log << ",lt" << s_bucketLimits[i] << "us";
+
+        m_log << ",ge" << s_bucketLimits[BucketCount - 2u] << "us" << std::endl;
+      } else {
+        Logger::warn(str::format("HUD: Failed to open frame stats log ", path));
+      }
+
+      m_logStart = dxvk::high_resolution_clock::now();
+    }
+  }
+
+
+  HudFrameStatsItem::~HudFrameStatsItem() {
+
+  }
+
+
+  void HudFrameStatsItem::update(dxvk::high_resolution_clock::time_point time) {
+    auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate);
+    m_frameTimes.push_back(uint32_t(std::min<int64_t>(frameTime.count(), ~0u)));
+    m_lastUpdate = time;
+
+    if (time - m_windowStart >= m_window) {
+      processWindow(time);
+      m_windowStart = time;
+    }
+  }
+
+
+  HudPos HudFrameStatsItem::render(
+    const DxvkContextObjects& ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    static const std::array<const char*, BucketCount> s_bucketNames = {
+      "< 8.3 ms:", "< 16.7 ms:", "< 33.3 ms:", "< 50 ms:", "< 100 ms:", ">= 100 ms:",
+    };
+
+    position.y += 16;
+    renderer.drawText(16, position, 0xff40ffffu, "Average:");
+    renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, m_avgString);
+
+    position.y += 20;
+    renderer.drawText(16, position, 0xff40ffffu, "1% low:");
+    renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, m_low1String);
+
+    position.y += 20;
+    renderer.drawText(16, position, 0xff40ffffu, "0.1% low:");
+    renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, m_low01String);
+
+    for (uint32_t i = 0; i < BucketCount; i++) {
+      if (m_bucketStrings[i].empty())
+        continue;
+
+      position.y += 20;
+      renderer.drawText(16, position, 0xff40ffffu, s_bucketNames[i]);
+      renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, m_bucketStrings[i]);
+    }
+
+    position.y += 8;
+    return position;
+  }
+
+
+  void HudFrameStatsItem::processWindow(
+          dxvk::high_resolution_clock::time_point time) {
+    size_t count = m_frameTimes.size();
+
+    if (!count)
+      return;
+
+    std::array<size_t, BucketCount> buckets = { };
+    uint64_t total = 0u;
+
+    for (uint32_t frameTime : m_frameTimes) {
+      size_t bucket = 0u;
+
+      while (bucket < s_bucketLimits.size() && frameTime >= s_bucketLimits[bucket])
+        bucket += 1u;
+
+      buckets[bucket] += 1u;
+      total += frameTime;
+    }
+
+    // Lows are reported as the frame rate at the
+    // 99th and 99.9th frame time percentile
+    std::sort(m_frameTimes.begin(), m_frameTimes.end());
+
+    uint64_t avg = total / count;
+    uint64_t p99 = m_frameTimes[std::min(count - 1u, (count * 99u) / 100u)];
+    uint64_t p999 = m_frameTimes[std::min(count - 1u, (count * 999u) / 1000u)];
+
+    m_avgString = formatFps(avg);
+    m_low1String = formatFps(p99);
+    m_low01String = formatFps(p999);
+
+    for (uint32_t i = 0; i < BucketCount; i++) {
+      uint64_t permille = (buckets[i] * 1000u) / count;
+
+      m_bucketStrings[i] = buckets[i]
+        ? str::format(permille / 10u, ".", permille % 10u, "%")
+        : std::string();
+    }
+
+    if (m_log.is_open()) {
+      auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(time - m_logStart);
+
+      m_log << timestamp.count() << ","
+            << count << ","
+            << avg << ","
+            << p99 << ","
+            << p999;
+
+      for (uint32_t i = 0; i < BucketCount; i++)
+        m_log << "," << buckets[i];
+
+      m_log << "\n";
+    }
+
+    m_frameTimes.clear();
+  }
+
+
+  std::string HudFrameStatsItem::formatFps(uint64_t frameTimeUs) {
+    uint64_t fps = frameTimeUs ? 10000000u / frameTimeUs : 0u;
+    return str::format(fps / 10u, ".", fps % 10u, " fps (", frameTimeUs / 1000u, ".", (frameTimeUs % 1000u) / 100u, " ms)");
+  }
+
+
   HudFrameTimeItem::HudFrameTimeItem(const Rc<DxvkDevice>& device, HudRenderer* renderer)
   : m_device            (device),
     m_gfxSetLayout      (createDescriptorSetLayout()),
@@ -930,7 +1079,18 @@ namespace dxvk::hud {
 
   HudMemoryStatsItem::HudMemoryStatsItem(const Rc<DxvkDevice>& device)
   : m_device(device), m_memory(device->adapter()->memoryProperties()) {
+    std::string path = env::getEnvVar("DXVK_HUD_MEMORY_LOG");
+
+    if (!path.empty()) {
+      m_log = std::ofstream(str::topath(path.c_str()).c_str(), std::ios_base::trunc);
 
+      if (m_log)
+        m_log << "time_ms,heap,allocated,used,budget" << std::endl;
+      else
+        Logger::warn(str::format("HUD: Failed to open memory log ", path));
+
+      m_logStart = dxvk::high_resolution_clock::now();
+    }
   }
 
 
@@ -942,6 +1102,39 @@ namespace dxvk::hud {
   void HudMemoryStatsItem::update(dxvk::high_resolution_clock::time_point time) {
     for (uint32_t i = 0; i < m_memory.memoryHeapCount; i++)
       m_heaps[i] = m_device->getMemoryStats(i);
+
+    // Record allocated memory at a fixed interval so that we
+    // can display how memory usage developed in recent history
+    auto& prevSample = m_samples[(m_sampleIndex + SampleCount - 1u) % SampleCount];
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - prevSample.time);
+
+    if (!m_sampleCount || elapsed.count() >= SampleInterval) {
+      auto& sample = m_samples[m_sampleIndex];
+      sample.time = time;
+
+      for (uint32_t i = 0; i < m_memory.memoryHeapCount; i++)
+        sample.memoryAllocated[i] = m_heaps[i].memoryAllocated;
+
+      m_sampleIndex = (m_sampleIndex + 1u) % SampleCount;
+      m_sampleCount = std::min(m_sampleCount + 1u, SampleCount);
+    }
+
+    if (m_log.is_open())
+      writeLog(time);
+  }
+
+
+  void HudMemoryStatsItem::writeLog(
+          dxvk::high_resolution_clock::time_point time) {
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(time - m_logStart);
+
+    for (uint32_t i = 0; i < m_memory.memoryHeapCount; i++) {
+      m_log << timestamp.count() << ","
+            << i << ","
+            << m_heaps[i].memoryAllocated << ","
+            << m_heaps[i].memoryUsed << ","
+            << m_heaps[i].memoryBudget << "\n";
+    }
   }
 
 
@@ -964,6 +1157,16 @@ namespace dxvk::hud {
       std::string text  = str::format(std::setfill(' '), std::setw(5), memAllocatedMib, " MB (", percentage, "%) ",
         std::setw(5 + (percentage < 10 ? 1 : 0) + (percentage < 100 ? 1 : 0)), memUsedMib, " MB used");
 
+      // Show how much allocated memory changed over the recorded history
+      // in order to make slow leaks and sawtooth patterns visible.
+      if (m_sampleCount == SampleCount) {
+        int64_t oldest = m_samples[m_sampleIndex].memoryAllocated[i] >> 20;
+        int64_t newest = m_samples[(m_sampleIndex + SampleCount - 1u) % SampleCount].memoryAllocated[i] >> 20;
+
+        text += str::format("  ", newest >= oldest ? "+" : "-",
+          std::abs(newest - oldest), " MB / ", (SampleCount * SampleInterval) / 1'000'000, "s");
+      }
+
       position.y += 16;
       renderer.drawText(16, position, 0xff40ffffu, label);
       renderer.drawText(16, { position.x + 168, position.y }, 0xffffffffu, text);
@@ -1475,6 +1678,213 @@ namespace dxvk::hud {
   }
 
 
+  HudCmdTimingItem::HudCmdTimingItem(const Rc<DxvkDevice>& device)
+  : m_device(device) {
+    m_device->enableCommandTimings();
+    m_prevCounters = m_device->getStatCounters();
+  }
+
+
+  HudCmdTimingItem::~HudCmdTimingItem() {
+
+  }
+
+
+  void HudCmdTimingItem::update(dxvk::high_resolution_clock::time_point time) {
+    uint64_t ticks = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate).count();
+
+    DxvkStatCounters counters = m_device->getStatCounters();
+    m_accumCounters.merge(counters.diff(m_prevCounters));
+    m_prevCounters = counters;
+
+    m_updateCount++;
+
+    if (ticks >= UpdateInterval) {
+      for (size_t i = 0; i < s_entries.size(); i++) {
+        // Counters are in nanoseconds, display average microseconds per frame
+        uint64_t us = m_accumCounters.getCtr(s_entries[i].counter) / (1000u * m_updateCount);
+        m_strings[i] = str::format(us, " us");
+      }
+
+      m_accumCounters.reset();
+
+      m_updateCount = 0;
+      m_lastUpdate = time;
+    }
+  }
+
+
+  HudPos HudCmdTimingItem::render(
+    const DxvkContextObjects& ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    for (size_t i = 0; i < s_entries.size(); i++) {
+      position.y += i ? 20 : 16;
+      renderer.drawText(16, position, 0xff40ffff, s_entries[i].name);
+      renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, m_strings[i]);
+    }
+
+    position.y += 8;
+    return position;
+  }
+
+
+  HudStutterItem::HudStutterItem(const Rc<DxvkDevice>& device)
+  : m_device(device), m_memory(device->adapter()->memoryProperties()) {
+    m_prevCounters = m_device->getStatCounters();
+    m_prevAllocated = getAllocatedMemory();
+  }
+
+
+  HudStutterItem::~HudStutterItem() {
+
+  }
+
+
+  void HudStutterItem::update(dxvk::high_resolution_clock::time_point time) {
+    uint64_t frameTime = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate).count();
+    m_lastUpdate = time;
+
+    DxvkStatCounters counters = m_device->getStatCounters();
+    DxvkStatCounters diff = counters.diff(m_prevCounters);
+    m_prevCounters = counters;
+
+    VkDeviceSize allocated = getAllocatedMemory();
+    VkDeviceSize allocatedDiff = allocated > m_prevAllocated ? allocated - m_prevAllocated : 0u;
+    m_prevAllocated = allocated;
+
+    // Compare against the history before adding the current frame
+    // so that a single long frame does not skew its own threshold
+    if (m_frameCount >= MinHistorySize) {
+      uint64_t median = getMedianFrameTime();
+
+      if (frameTime > 2u * median && frameTime > median + 4000u) {
+        uint64_t pipelines = diff.getCtr(DxvkStatCounter::PipeCountGraphics)
+                           + diff.getCtr(DxvkStatCounter::PipeCountLibrary)
+                           + diff.getCtr(DxvkStatCounter::PipeCountCompute);
+
+        uint64_t csSyncCount = diff.getCtr(DxvkStatCounter::CsSyncCount);
+        uint64_t csSyncTicks = diff.getCtr(DxvkStatCounter::CsSyncTicks);
+        uint64_t gpuSyncCount = diff.getCtr(DxvkStatCounter::GpuSyncCount);
+        uint64_t gpuSyncTicks = diff.getCtr(DxvkStatCounter::GpuSyncTicks);
+
+        m_stutterCount += 1u;
+
+        m_frameString = str::format(frameTime / 1000u, ".", (frameTime % 1000u) / 100u, " ms (median ",
+          median / 1000u, ".", (median % 1000u) / 100u, " ms)");
+        m_causeString = str::format(pipelines, " pipelines, ",
+          allocatedDiff >> 20, " MB alloc, ",
+          csSyncCount, " CS syncs (", csSyncTicks / 1000u, " ms), ",
+          gpuSyncCount, " GPU syncs (", gpuSyncTicks / 1000u, " ms)");
+
+        Logger::info(str::format("Stutter: ", m_frameString, ": ", m_causeString));
+      }
+    }
+
+    m_frameTimes[m_frameIndex] = frameTime;
+    m_frameIndex = (m_frameIndex + 1u) % HistorySize;
+    m_frameCount = std::min(m_frameCount + 1u, HistorySize);
+  }
+
+
+  HudPos HudStutterItem::render(
+    const DxvkContextObjects& ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    position.y += 16;
+    renderer.drawText(16, position, 0xff4040ff, "Stutters:");
+    renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu,
+      m_stutterCount ? str::format(m_stutterCount, ", last ", m_frameString) : str::format(m_stutterCount));
+
+    if (m_stutterCount) {
+      position.y += 20;
+      renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, m_causeString);
+    }
+
+    position.y += 8;
+    return position;
+  }
+
+
+  VkDeviceSize HudStutterItem::getAllocatedMemory() const {
+    VkDeviceSize allocated = 0u;
+
+    for (uint32_t i = 0; i < m_memory.memoryHeapCount; i++)
+      allocated += m_device->getMemoryStats(i).memoryAllocated;
+
+    return allocated;
+  }
+
+
+  uint64_t HudStutterItem::getMedianFrameTime() const {
+    std::array<uint64_t, HistorySize> frameTimes = m_frameTimes;
+
+    auto end = frameTimes.begin() + m_frameCount;
+    auto mid = frameTimes.begin() + m_frameCount / 2u;
+    std::nth_element(frameTimes.begin(), mid, end);
+    return *mid;
+  }
+
+
+  HudCompileTimeItem::HudCompileTimeItem(const Rc<DxvkDevice>& device)
+  : m_device(device) {
+
+  }
+
+
+  HudCompileTimeItem::~HudCompileTimeItem() {
+
+  }
+
+
+  void HudCompileTimeItem::update(dxvk::high_resolution_clock::time_point time) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate);
+
+    if (elapsed.count() >= UpdateInterval) {
+      m_times = m_device->getPipelineCompileTimes();
+      m_lastUpdate = time;
+    }
+  }
+
+
+  HudPos HudCompileTimeItem::render(
+    const DxvkContextObjects& ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    static const std::array<const char*, DxvkPipelineCompileTimes::BucketCount> s_bucketNames = {
+      "< 1 ms:", "< 5 ms:", "< 20 ms:", "< 50 ms:", "< 200 ms:", ">= 200 ms:",
+    };
+
+    position.y += 16;
+    renderer.drawText(16, position, 0xffff80c0u, "Compile times:");
+
+    for (uint32_t i = 0; i < DxvkPipelineCompileTimes::BucketCount; i++) {
+      position.y += 20;
+      renderer.drawText(16, position, 0xffff80c0u, s_bucketNames[i]);
+      renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, str::format(m_times.histogram[i]));
+    }
+
+    uint32_t slowestCount = std::min<uint32_t>(m_times.slowest.size(), SlowestCount);
+
+    for (uint32_t i = 0; i < slowestCount; i++) {
+      const auto& entry = m_times.slowest[i];
+
+      position.y += 20;
+      renderer.drawText(16, position, 0xffff80c0u, str::format(entry.us / 1000u, " ms"));
+      renderer.drawText(16, { position.x + 132, position.y }, 0xffffffffu, entry.name);
+    }
+
+    position.y += 8;
+    return position;
+  }
+
+
   HudGpuLoadItem::HudGpuLoadItem(const Rc<DxvkDevice>& device)
   : m_device(device) {
 
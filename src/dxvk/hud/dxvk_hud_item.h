@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -100,7 +102,7 @@ namespace dxvk::hud {
      */
     template<typename T, typename... Args>
     Rc<T> add(const char* name, int32_t at, Args... args) {
-      bool enable = m_enableFull;
+      bool enable = m_enableFull && isPartOfFull(name);
 
       if (!enable) {
         auto entry = m_enabled.find(name);
@@ -140,6 +142,8 @@ namespace dxvk::hud {
 
     static void parseOption(const std::string& str, float& value);
 
+    static bool isPartOfFull(const char* name);
+
   };
 
 
@@ -246,6 +250,62 @@ namespace dxvk::hud {
   };
 
 
+  /**
+   * \brief HUD item to display frame time percentiles
+   *
+   * Collects frame times over a fixed window and computes
+   * 1% and 0.1% lows as well as a frame time histogram.
+   * Results can optionally be written to a CSV file.
+   */
+  class HudFrameStatsItem : public HudItem {
+    constexpr static size_t BucketCount = 6u;
+
+    constexpr static std::array<uint32_t, BucketCount - 1u> s_bucketLimits = {
+      8333u, 16667u, 33333u, 50000u, 100000u,
+    };
+  public:
+
+    HudFrameStatsItem(float window);
+
+    ~HudFrameStatsItem();
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const DxvkContextObjects& ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    std::chrono::microseconds m_window;
+
+    std::vector<uint32_t> m_frameTimes;
+
+    std::string m_avgString;
+    std::string m_low1String;
+    std::string m_low01String;
+
+    std::array<std::string, BucketCount> m_bucketStrings;
+
+    std::ofstream m_log;
+
+    dxvk::high_resolution_clock::time_point m_logStart = { };
+    dxvk::high_resolution_clock::time_point m_windowStart
+      = dxvk::high_resolution_clock::now();
+    dxvk::high_resolution_clock::time_point m_lastUpdate
+      = dxvk::high_resolution_clock::now();
+
+    void processWindow(
+            dxvk::high_resolution_clock::time_point time);
+
+    static std::string formatFps(uint64_t frameTimeUs);
+
+  };
+
+
   /**
    * \brief HUD item to display the frame rate
    */
@@ -500,7 +560,8 @@ namespace dxvk::hud {
    * \brief HUD item to display memory usage
    */
   class HudMemoryStatsItem : public HudItem {
-
+    constexpr static int64_t SampleInterval = 100'000;
+    constexpr static size_t  SampleCount = 100u;
   public:
 
     HudMemoryStatsItem(const Rc<DxvkDevice>& device);
@@ -518,10 +579,25 @@ namespace dxvk::hud {
 
   private:
 
+    struct Sample {
+      dxvk::high_resolution_clock::time_point time = { };
+      std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> memoryAllocated = { };
+    };
+
     Rc<DxvkDevice>                    m_device;
     VkPhysicalDeviceMemoryProperties  m_memory;
     DxvkMemoryStats                   m_heaps[VK_MAX_MEMORY_HEAPS];
 
+    std::array<Sample, SampleCount>   m_samples = { };
+    size_t                            m_sampleIndex = 0u;
+    size_t                            m_sampleCount = 0u;
+
+    std::ofstream                     m_log;
+    dxvk::high_resolution_clock::time_point m_logStart = { };
+
+    void writeLog(
+            dxvk::high_resolution_clock::time_point time);
+
   };
 
 
@@ -661,6 +737,139 @@ namespace dxvk::hud {
   };
 
 
+  /**
+   * \brief HUD item to display CPU time of context state updates
+   */
+  class HudCmdTimingItem : public HudItem {
+    constexpr static int64_t UpdateInterval = 500'000;
+  public:
+
+    HudCmdTimingItem(const Rc<DxvkDevice>& device);
+
+    ~HudCmdTimingItem();
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const DxvkContextObjects& ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    struct Entry {
+      DxvkStatCounter counter;
+      const char*     name;
+    };
+
+    static constexpr std::array<Entry, 4> s_entries = {{
+      { DxvkStatCounter::CmdPipelineTicks,     "Pipelines:" },
+      { DxvkStatCounter::CmdBindingTicks,      "Bindings:" },
+      { DxvkStatCounter::CmdBarrierTicks,      "Barriers:" },
+      { DxvkStatCounter::CmdVertexBufferTicks, "Vertex buffers:" },
+    }};
+
+    Rc<DxvkDevice>    m_device;
+
+    DxvkStatCounters  m_prevCounters;
+    DxvkStatCounters  m_accumCounters;
+
+    uint64_t          m_updateCount = 0;
+
+    std::array<std::string, s_entries.size()> m_strings;
+
+    dxvk::high_resolution_clock::time_point m_lastUpdate
+      = dxvk::high_resolution_clock::now();
+
+  };
+
+
+  /**
+   * \brief HUD item to detect and explain stutter
+   *
+   * Flags frames that take significantly longer than the
+   * median of recent frames, and records pipeline compiles,
+   * memory allocations and CPU-side syncs that happened
+   * during those frames. Reports are also written to the log.
+   */
+  class HudStutterItem : public HudItem {
+    constexpr static size_t  HistorySize = 128u;
+    constexpr static size_t  MinHistorySize = 32u;
+  public:
+
+    HudStutterItem(const Rc<DxvkDevice>& device);
+
+    ~HudStutterItem();
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const DxvkContextObjects& ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    Rc<DxvkDevice>                    m_device;
+    VkPhysicalDeviceMemoryProperties  m_memory;
+
+    DxvkStatCounters                  m_prevCounters;
+    VkDeviceSize                      m_prevAllocated = 0u;
+
+    std::array<uint64_t, HistorySize> m_frameTimes = { };
+    size_t                            m_frameIndex = 0u;
+    size_t                            m_frameCount = 0u;
+
+    uint64_t                          m_stutterCount = 0u;
+
+    std::string                       m_frameString;
+    std::string                       m_causeString;
+
+    dxvk::high_resolution_clock::time_point m_lastUpdate
+      = dxvk::high_resolution_clock::now();
+
+    VkDeviceSize getAllocatedMemory() const;
+
+    uint64_t getMedianFrameTime() const;
+
+  };
+
+
+  /**
+   * \brief HUD item to display pipeline compile times
+   */
+  class HudCompileTimeItem : public HudItem {
+    constexpr static int64_t UpdateInterval = 500'000;
+    constexpr static uint32_t SlowestCount = 3u;
+  public:
+
+    HudCompileTimeItem(const Rc<DxvkDevice>& device);
+
+    ~HudCompileTimeItem();
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const DxvkContextObjects& ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    Rc<DxvkDevice>            m_device;
+    DxvkPipelineCompileTimes  m_times;
+
+    dxvk::high_resolution_clock::time_point m_lastUpdate = { };
+
+  };
+
+
   /**
    * \brief HUD item to display GPU load
    */
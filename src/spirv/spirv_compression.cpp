@@ -95,6 +95,28 @@ namespace dxvk {
 
     constexpr uint32_t shiftAmounts = 0x0c101420;
 
+    // Each block decodes to at most 32 DWORDs, so as long as that many
+    // DWORDs are left in the output, we can skip all bounds checks and
+    // store the second token unconditionally. For single-token schemas,
+    // that store is either zero or overwritten by the next token.
+    while (dstOffset + 32u <= m_size) {
+      uint32_t blockMask = m_code[srcOffset];
+
+      for (uint32_t i = 0; i < 16; i++) {
+        uint32_t schema = (blockMask >> (i << 1)) & 0x3;
+        uint32_t shift  = (shiftAmounts >> (schema << 3)) & 0xff;
+        uint64_t mask   = ~(~0ull << shift);
+        uint64_t encode = m_code[srcOffset + i + 1];
+
+        data[dstOffset + 0] = encode & mask;
+        data[dstOffset + 1] = encode >> shift;
+
+        dstOffset += schema ? 2 : 1;
+      }
+
+      srcOffset += 17;
+    }
+
     while (dstOffset < m_size) {
       uint32_t blockMask = m_code[srcOffset];
 
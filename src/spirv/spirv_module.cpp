@@ -800,6 +800,9 @@ namespace dxvk {
           uint32_t                typeId,
           uint32_t                length) {
     uint32_t resultId = this->allocateId();
+
+    std::array<uint32_t, 2> args = { typeId, length };
+    indexTypeConst(spv::OpTypeArray, 0, args.size(), args.data());
     
     m_typeConstDefs.putIns (spv::OpTypeArray, 4);
     m_typeConstDefs.putWord(resultId);
@@ -821,6 +824,7 @@ namespace dxvk {
   uint32_t SpirvModule::defRuntimeArrayTypeUnique(
           uint32_t                typeId) {
     uint32_t resultId = this->allocateId();
+    indexTypeConst(spv::OpTypeRuntimeArray, 0, 1, &typeId);
     
     m_typeConstDefs.putIns (spv::OpTypeRuntimeArray, 3);
     m_typeConstDefs.putWord(resultId);
@@ -856,6 +860,7 @@ namespace dxvk {
           uint32_t                memberCount,
     const uint32_t*               memberTypes) {
     uint32_t resultId = this->allocateId();
+    indexTypeConst(spv::OpTypeStruct, 0, memberCount, memberTypes);
     
     m_typeConstDefs.putIns (spv::OpTypeStruct, 2 + memberCount);
     m_typeConstDefs.putWord(resultId);
@@ -3766,22 +3771,40 @@ namespace dxvk {
           spv::Op                 op, 
           uint32_t                argCount,
     const uint32_t*               argIds) {
-    // Since the type info is stored in the code buffer,
-    // we can use the code buffer to look up type IDs as
-    // well. Result IDs are always stored as argument 1.
-    for (auto ins : m_typeConstDefs) {
+    // Since the type info is stored in the code buffer, we can
+    // use the code buffer to look up type IDs as well, using the
+    // hash index to find candidates. Result IDs are always stored
+    // as argument 1. If there are multiple matches, return the one
+    // that was declared first.
+    auto entries = m_typeConstIndex.equal_range(
+      hashTypeConst(op, 0, argCount, argIds));
+
+    uint32_t resultId = 0;
+    uint32_t resultOffset = ~0u;
+
+    for (auto e = entries.first; e != entries.second; e++) {
+      SpirvInstruction ins(m_typeConstDefs.data(), e->second, m_typeConstDefs.dwords());
+
       bool match = ins.opCode() == op
-                && ins.length() == 2 + argCount;
+                && ins.length() == 2 + argCount
+                && ins.offset() < resultOffset;
       
       for (uint32_t i = 0; i < argCount && match; i++)
         match &= ins.arg(2 + i) == argIds[i];
       
-      if (match)
-        return ins.arg(1);
+      if (match) {
+        resultId = ins.arg(1);
+        resultOffset = ins.offset();
+      }
     }
+
+    if (resultId)
+      return resultId;
     
     // Type not yet declared, create a new one.
-    uint32_t resultId = this->allocateId();
+    resultId = this->allocateId();
+    indexTypeConst(op, 0, argCount, argIds);
+
     m_typeConstDefs.putIns (op, 2 + argCount);
     m_typeConstDefs.putWord(resultId);
     
@@ -3796,26 +3819,38 @@ namespace dxvk {
           uint32_t                typeId,
           uint32_t                argCount,
     const uint32_t*               argIds) {
-    // Avoid declaring constants multiple times
-    for (auto ins : m_typeConstDefs) {
+    // Avoid declaring constants multiple times. Late constants
+    // are never added to the index since they can be modified.
+    auto entries = m_typeConstIndex.equal_range(
+      hashTypeConst(op, typeId, argCount, argIds));
+
+    uint32_t resultId = 0;
+    uint32_t resultOffset = ~0u;
+
+    for (auto e = entries.first; e != entries.second; e++) {
+      SpirvInstruction ins(m_typeConstDefs.data(), e->second, m_typeConstDefs.dwords());
+
       bool match = ins.opCode() == op
                 && ins.length() == 3 + argCount
-                && ins.arg(1)   == typeId;
+                && ins.arg(1)   == typeId
+                && ins.offset() < resultOffset;
       
       for (uint32_t i = 0; i < argCount && match; i++)
         match &= ins.arg(3 + i) == argIds[i];
       
-      if (!match)
-        continue;
-      
-      uint32_t id = ins.arg(2);
-
-      if (m_lateConsts.find(id) == m_lateConsts.end())
-        return id;
+      if (match) {
+        resultId = ins.arg(2);
+        resultOffset = ins.offset();
+      }
     }
+
+    if (resultId)
+      return resultId;
     
     // Constant not yet declared, make a new one
-    uint32_t resultId = this->allocateId();
+    resultId = this->allocateId();
+    indexTypeConst(op, typeId, argCount, argIds);
+
     m_typeConstDefs.putIns (op, 3 + argCount);
     m_typeConstDefs.putWord(typeId);
     m_typeConstDefs.putWord(resultId);
@@ -3826,6 +3861,32 @@ namespace dxvk {
   }
   
   
+  size_t SpirvModule::hashTypeConst(
+          spv::Op                 op,
+          uint32_t                typeId,
+          uint32_t                argCount,
+    const uint32_t*               argIds) const {
+    size_t hash = size_t(op) | (size_t(argCount) << 16);
+    hash ^= typeId + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    for (uint32_t i = 0; i < argCount; i++)
+      hash ^= argIds[i] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    return hash;
+  }
+
+
+  void SpirvModule::indexTypeConst(
+          spv::Op                 op,
+          uint32_t                typeId,
+          uint32_t                argCount,
+    const uint32_t*               argIds) {
+    m_typeConstIndex.insert({
+      hashTypeConst(op, typeId, argCount, argIds),
+      m_typeConstDefs.dwords() });
+  }
+
+
   void SpirvModule::instImportGlsl450() {
     m_instExtGlsl450 = this->allocateId();
     const char* name = "GLSL.std.450";
@@ -1298,6 +1298,8 @@ namespace dxvk {
 
     std::unordered_set<uint32_t> m_lateConsts;
 
+    std::unordered_multimap<size_t, uint32_t> m_typeConstIndex;
+
     std::vector<uint32_t> m_interfaceVars;
 
     uint32_t defType(
@@ -1311,6 +1313,18 @@ namespace dxvk {
             uint32_t                argCount,
       const uint32_t*               argIds);
     
+    size_t hashTypeConst(
+            spv::Op                 op,
+            uint32_t                typeId,
+            uint32_t                argCount,
+      const uint32_t*               argIds) const;
+
+    void indexTypeConst(
+            spv::Op                 op,
+            uint32_t                typeId,
+            uint32_t                argCount,
+      const uint32_t*               argIds);
+
     void instImportGlsl450();
     
     uint32_t getMemoryOperandWordCount(
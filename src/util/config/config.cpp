@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <array>
+#include <cctype>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -1211,11 +1214,53 @@ namespace dxvk {
   }};
 
 
+  /**
+   * \brief Matches a profile pattern against an app name
+   *
+   * Most patterns are plain case-insensitive suffix matches
+   * on the executable path, such as \\Game\.exe$. Compare
+   * those directly, since constructing a regex is expensive and
+   * the profile list is walked on every process start.
+   */
+  static bool matchProfile(const char* pattern, const std::string& appName) {
+    std::string literal;
+    bool isLiteral = false;
+
+    for (const char* c = pattern; *c; c++) {
+      if (c[0] == '\\') {
+        if (!c[1] || !std::strchr(".[]()*+?{}|^$\\", c[1]))
+          break;
+
+        literal.push_back(*(++c));
+      } else if (c[0] == '$') {
+        isLiteral = !c[1];
+        break;
+      } else if (std::strchr(".[]()*+?{}|^", c[0])) {
+        break;
+      } else {
+        literal.push_back(c[0]);
+      }
+    }
+
+    if (!isLiteral) {
+      std::regex expr(pattern, std::regex::extended | std::regex::icase);
+      return std::regex_search(appName, expr);
+    }
+
+    if (literal.size() > appName.size())
+      return false;
+
+    return std::equal(literal.begin(), literal.end(), appName.end() - literal.size(),
+      [] (char a, char b) {
+        return std::tolower(uint8_t(a)) == std::tolower(uint8_t(b));
+      });
+  }
+
+
   const Config* findProfile(const ProfileList& profiles, const std::string& appName) {
     auto appConfig = std::find_if(profiles.begin(), profiles.end(),
       [&appName] (const std::pair<const char*, Config>& pair) {
-        std::regex expr(pair.first, std::regex::extended | std::regex::icase);
-        return std::regex_search(appName, expr);
+        return matchProfile(pair.first, appName);
       });
 
     return appConfig != profiles.end()
@@ -12,7 +12,10 @@ namespace dxvk {
   }
   
   
-  Logger::~Logger() { }
+  Logger::~Logger() {
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+    flushRepeatCount();
+  }
   
   
   void Logger::trace(const std::string& message) {
@@ -49,11 +52,6 @@ namespace dxvk {
     if (level >= m_minLevel) {
       std::lock_guard<dxvk::mutex> lock(m_mutex);
       
-      static std::array<const char*, 5> s_prefixes
-        = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
-      
-      const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
-
       if (!std::exchange(m_initialized, true)) {
 #ifdef _WIN32
         HMODULE ntdll = GetModuleHandleA("ntdll.dll");
@@ -67,51 +65,93 @@ namespace dxvk {
           m_fileStream = std::ofstream(str::topath(path.c_str()).c_str());
       }
 
-      std::stringstream stream(message);
-      std::string line;
+      // Collapse identical consecutive messages, such as warnings that
+      // get logged for every single draw, so that we do not end up
+      // spending most of our time writing the same line repeatedly.
+      if (level == m_lastLevel && message == m_lastMessage) {
+        auto now = high_resolution_clock::now();
+
+        if (!(m_repeatCount++))
+          m_repeatStart = now;
+
+        // Periodically report the repeat count so that long-running
+        // message storms still show up in the log before they end
+        if (m_repeatCount >= 1000u || now - m_repeatStart >= std::chrono::seconds(1))
+          flushRepeatCount();
+
+        return;
+      }
+
+      flushRepeatCount();
+
+      m_lastLevel = level;
+      m_lastMessage = message;
+
+      writeMsg(level, message);
+    }
+  }
+
+
+  void Logger::flushRepeatCount() {
+    if (!m_repeatCount)
+      return;
+
+    writeMsg(m_lastLevel, "(previous message repeated "
+      + std::to_string(m_repeatCount) + " times)");
+    m_repeatCount = 0u;
+  }
 
-      while (std::getline(stream, line, '\n')) {
-        std::stringstream outstream;
-        outstream << prefix << line << std::endl;
 
-        std::string adjusted = outstream.str();
+  void Logger::writeMsg(LogLevel level, const std::string& message) {
+    static std::array<const char*, 5> s_prefixes
+      = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
 
-        if (!adjusted.empty()) {
+    const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
+
+    std::stringstream stream(message);
+    std::string line;
+
+    while (std::getline(stream, line, '\n')) {
+      std::stringstream outstream;
+      outstream << prefix << line << std::endl;
+
+      std::string adjusted = outstream.str();
+
+      if (!adjusted.empty()) {
 #ifdef _WIN32
-          if (m_wineLogOutput) {
-            // __wine_dbg_output tries to buffer lines up to 1020 characters
-            // including null terminator, and will cause a hang if we submit
-            // anything longer than that even in consecutive calls. Work
-            // around this by splitting long lines into multiple lines.
-            constexpr size_t MaxDebugBufferLength = 1018;
-
-            if (adjusted.size() <= MaxDebugBufferLength) {
-              m_wineLogOutput(adjusted.c_str());
-            } else {
-              std::array<char, MaxDebugBufferLength + 2u> buffer;
-
-              for (size_t i = 0; i < adjusted.size(); i += MaxDebugBufferLength) {
-                size_t size = std::min(adjusted.size() - i, MaxDebugBufferLength);
-
-                std::strncpy(buffer.data(), &adjusted[i], size);
-                if (buffer[size - 1u] != '\n')
-                  buffer[size++] = '\n';
-
-                buffer[size] = '\0';
-                m_wineLogOutput(buffer.data());
-              }
-            }
+        if (m_wineLogOutput) {
+          // __wine_dbg_output tries to buffer lines up to 1020 characters
+          // including null terminator, and will cause a hang if we submit
+          // anything longer than that even in consecutive calls. Work
+          // around this by splitting long lines into multiple lines.
+          constexpr size_t MaxDebugBufferLength = 1018;
+
+          if (adjusted.size() <= MaxDebugBufferLength) {
+            m_wineLogOutput(adjusted.c_str());
           } else {
-            std::cerr << adjusted;
+            std::array<char, MaxDebugBufferLength + 2u> buffer;
+
+            for (size_t i = 0; i < adjusted.size(); i += MaxDebugBufferLength) {
+              size_t size = std::min(adjusted.size() - i, MaxDebugBufferLength);
+
+              std::strncpy(buffer.data(), &adjusted[i], size);
+              if (buffer[size - 1u] != '\n')
+                buffer[size++] = '\n';
+
+              buffer[size] = '\0';
+              m_wineLogOutput(buffer.data());
+            }
           }
-#else
+        } else {
           std::cerr << adjusted;
-#endif
         }
-
-        if (m_fileStream)
-          m_fileStream << adjusted;
+#else
+        std::cerr << adjusted;
+#endif
       }
+
+      if (m_fileStream)
+        m_fileStream << adjusted;
     }
   }
   
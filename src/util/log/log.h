@@ -6,6 +6,7 @@
 #include <string>
 
 #include "../thread.h"
+#include "../util_time.h"
 
 namespace dxvk {
   
@@ -57,11 +58,22 @@ namespace dxvk {
     std::ofstream     m_fileStream;
 
     bool              m_initialized = false;
+
+    LogLevel          m_lastLevel = LogLevel::None;
+    std::string       m_lastMessage;
+    uint32_t          m_repeatCount = 0u;
+
+    high_resolution_clock::time_point m_repeatStart;
+
 #ifdef _WIN32
     PFN_wineLogOutput m_wineLogOutput = nullptr;
 #endif
 
     void emitMsg(LogLevel level, const std::string& message);
+
+    void writeMsg(LogLevel level, const std::string& message);
+
+    void flushRepeatCount();
     
     std::string getFileName(
       const std::string& base);
@@ -9,6 +9,22 @@
 
 namespace dxvk::sync {
 
+  /**
+   * \brief Issues a CPU pause hint
+   *
+   * Used inside spin loops to reduce power
+   * consumption and memory order violations.
+   */
+  inline void pause() {
+    #if defined(DXVK_ARCH_X86)
+    _mm_pause();
+    #elif defined(DXVK_ARCH_ARM64)
+    __asm__ __volatile__ ("yield");
+    #else
+    #error "Pause/Yield not implemented for this architecture."
+    #endif
+  }
+
   /**
    * \brief Generic spin function
    *
@@ -21,13 +37,8 @@ namespace dxvk::sync {
   void spin(uint32_t spinCount, const Fn& fn) {
     while (unlikely(!fn())) {
       for (uint32_t i = 1; i < spinCount; i++) {
-        #if defined(DXVK_ARCH_X86)
-        _mm_pause();
-        #elif defined(DXVK_ARCH_ARM64)
-        __asm__ __volatile__ ("yield");
-        #else
-        #error "Pause/Yield not implemented for this architecture."
-        #endif
+        pause();
+
         if (fn())
           return;
       }
@@ -35,6 +46,29 @@ namespace dxvk::sync {
       dxvk::this_thread::yield();
     }
   }
+
+  /**
+   * \brief Bounded spin function
+   *
+   * Probes a condition a limited number of times without
+   * yielding. Useful to avoid putting the calling thread
+   * to sleep if the condition is likely to become \c true
+   * within a very short amount of time.
+   * \param [in] spinCount Maximum number of probes
+   * \param [in] fn Condition to test
+   * \returns \c true if the condition became \c true
+   */
+  template<typename Fn>
+  bool spinFor(uint32_t spinCount, const Fn& fn) {
+    for (uint32_t i = 0; i < spinCount; i++) {
+      if (fn())
+        return true;
+
+      pause();
+    }
+
+    return fn();
+  }
   
   /**
    * \brief Spin lock
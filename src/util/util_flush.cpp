@@ -14,9 +14,10 @@ namespace dxvk {
           uint32_t              lastCompleteSubmissionId) {
     constexpr uint32_t minPendingSubmissions = 2;
 
-    constexpr uint32_t minChunkCount =  3u;
     constexpr uint32_t maxChunkCount = 20u;
 
+    uint32_t minChunkCount = m_minChunkCount;
+
     // Do not flush if there is nothing to flush
     uint32_t chunkCount = uint32_t(chunkId - m_lastFlushChunkId);
 
@@ -85,4 +86,34 @@ namespace dxvk {
     m_lastFlushSubmissionId = submissionId;
   }
 
+
+
+  void GpuFlushTracker::notifyFrame(
+          uint64_t              frameTime,
+          uint64_t              gpuIdleTime,
+          uint64_t              csSyncTime) {
+    if (m_ensureReproducibleHeuristic || !frameTime)
+      return;
+
+    // Only adjust the threshold by one step per frame so that
+    // a single outlier frame does not change behaviour much.
+    bool gpuStarved = gpuIdleTime * 8u > frameTime;
+    bool gpuBusy = gpuIdleTime * 32u < frameTime;
+    bool csBound = csSyncTime * 8u > frameTime;
+
+    if (gpuStarved) {
+      if (m_minChunkCount > MinChunkCountLow)
+        m_minChunkCount -= 1u;
+    } else if (gpuBusy) {
+      uint32_t maxChunkCount = csBound
+        ? MinChunkCountHigh
+        : MinChunkCountDefault;
+
+      if (m_minChunkCount < maxChunkCount)
+        m_minChunkCount += 1u;
+      else if (m_minChunkCount > maxChunkCount)
+        m_minChunkCount -= 1u;
+    }
+  }
+
 }
@@ -61,10 +61,33 @@ namespace dxvk {
             uint64_t              chunkId,
             uint64_t              submissionId);
 
+    /**
+     * \brief Adjusts flush heuristic at the end of a frame
+     *
+     * Lowers the number of chunks required for a flush if the GPU
+     * went idle during the last frame, so that work gets submitted
+     * earlier. Conversely, if the GPU was kept busy and the app spent
+     * significant time waiting for the CS thread, raises the chunk
+     * count in order to reduce submission overhead.
+     * \param [in] frameTime Duration of the frame, in microseconds
+     * \param [in] gpuIdleTime GPU idle time during the frame, in microseconds
+     * \param [in] csSyncTime Time spent waiting for the CS thread, in microseconds
+     */
+    void notifyFrame(
+            uint64_t              frameTime,
+            uint64_t              gpuIdleTime,
+            uint64_t              csSyncTime);
+
   private:
 
+    constexpr static uint32_t MinChunkCountLow      = 2u;
+    constexpr static uint32_t MinChunkCountDefault  = 3u;
+    constexpr static uint32_t MinChunkCountHigh     = 6u;
+
     bool          m_ensureReproducibleHeuristic;
 
+    uint32_t      m_minChunkCount         = MinChunkCountDefault;
+
     GpuFlushType  m_lastMissedType        = GpuFlushType::ImplicitWeakHint;
 
     uint64_t      m_lastFlushChunkId      = 0ull;